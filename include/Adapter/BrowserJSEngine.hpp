@@ -27,8 +27,18 @@ class BrowserJSEngine final : public VggJSEngine
 public:
   bool evalScript(const std::string& code) override;
   bool evalModule(const std::string& code) override;
-  bool evalModule(const std::string& code, VGG::EventPtr event, std::shared_ptr<IVggEnv> env)
-    override;
+  bool evalModule(
+    const std::string&       handlerKey,
+    const std::string&       code,
+    VGG::EventPtr            event,
+    std::shared_ptr<IVggEnv> env) override;
+  void clearModuleCache() override
+  {
+  }
+  bool postEvent(
+    const std::string&       event,
+    const std::string&       coalesceKey,
+    std::shared_ptr<IVggEnv> env) override;
 
   void openUrl(const std::string& url, const std::string& target) override;
 
@@ -17,8 +17,10 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include "Domain/Event.hpp"
 #include "Domain/IVggEnv.hpp"
 #include "Domain/VggJSEngine.hpp"
@@ -42,8 +44,16 @@ public:
 
   bool evalScript(const std::string& code) override;
   bool evalModule(const std::string& code) override;
-  bool evalModule(const std::string& code, VGG::EventPtr event, std::shared_ptr<IVggEnv> env)
-    override;
+  bool evalModule(
+    const std::string&       handlerKey,
+    const std::string&       code,
+    VGG::EventPtr            event,
+    std::shared_ptr<IVggEnv> env) override;
+  void clearModuleCache() override;
+  bool postEvent(
+    const std::string&       event,
+    const std::string&       coalesceKey,
+    std::shared_ptr<IVggEnv> env) override;
 
   void openUrl(const std::string& url, const std::string& target) override;
 
@@ -56,6 +66,10 @@ private:
   std::shared_ptr<std::thread>    m_thread;
   std::shared_ptr<NativeExecImpl> m_impl;
 
+  // key: hash of the code sent to node for it
+  std::unordered_map<std::string, std::size_t> m_importedHandlers;
+  std::mutex                                   m_importedHandlersMutex;
+
   NativeExec();
 
   void teardown();
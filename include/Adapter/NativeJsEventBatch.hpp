@@ -0,0 +1,68 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace VGG
+{
+
+// An event for the js listener of an env, see NativeExec::postEvent
+struct NativeJsEvent
+{
+  // containerKey, envKey, instanceKey, listenerKey, currentEnvName, currentVggName, event json
+  static constexpr std::size_t ARGS_SIZE = 7;
+
+  std::vector<std::string> m_args;
+  std::string              m_coalesce_key;
+};
+
+// Events posted before the node thread gets to them, delivered to js in one call.
+// A later event replaces a pending one with the same coalesce key and listener, unless an event
+// that can not be coalesced lies between them. A full batch drops its oldest coalescable event to
+// make room; events that can not be coalesced are never dropped, add() refuses them instead and
+// the caller starts a new batch.
+class NativeJsEventBatch
+{
+public:
+  static constexpr std::size_t MAX_SIZE = 1024; // js is not keeping up when reached
+
+  explicit NativeJsEventBatch(std::size_t maxSize = MAX_SIZE)
+    : m_maxSize(maxSize)
+  {
+  }
+
+  // Returns false if the batch is full, `event` is not moved from then.
+  bool add(NativeJsEvent&& event);
+
+  const std::vector<NativeJsEvent>& events() const
+  {
+    return m_events;
+  }
+  std::size_t droppedEvents() const
+  {
+    return m_droppedEvents;
+  }
+
+private:
+  std::size_t                m_maxSize;
+  std::vector<NativeJsEvent> m_events;
+  std::size_t                m_droppedEvents = 0;
+};
+
+} // namespace VGG
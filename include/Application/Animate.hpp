@@ -18,14 +18,15 @@
 #include <chrono>
 #include <functional>
 #include <cassert>
+#include <cstddef>
 #include <vector>
 #include <array>
 #include <optional>
+#include "Application/AnimationClock.hpp"
 
 namespace VGG
 {
 
-class Timer;
 class LayoutNode;
 class AttrBridge;
 using std::chrono::milliseconds;
@@ -53,6 +54,15 @@ public:
     double       to,
     milliseconds duration) = 0;
 
+  // Interpolates `count` values in one pass, out[i] = value between from[i] and to[i].
+  virtual void interpolate(
+    milliseconds  passedTime,
+    milliseconds  duration,
+    const double* from,
+    const double* to,
+    double*       out,
+    std::size_t   count);
+
   auto isFinished();
 
 protected:
@@ -67,10 +77,20 @@ class LinearInterpolator : public Interpolator
 public:
   virtual double operator()(milliseconds passedTime, double from, double to, milliseconds duration)
     override;
+
+  virtual void interpolate(
+    milliseconds  passedTime,
+    milliseconds  duration,
+    const double* from,
+    const double* to,
+    double*       out,
+    std::size_t   count) override;
 };
 
 class Animate
 {
+  friend class AnimateManage;
+
 public:
   Animate(milliseconds duration, milliseconds interval, std::shared_ptr<Interpolator> interpolator);
   Animate(Animate* parent);
@@ -98,6 +118,12 @@ protected:
   steady_clock::time_point getStartTime();
   milliseconds             getPassedTime();
   Animate*                 getParent();
+  Animate*                 getRoot();
+
+  // The values of all NumberAnimates under an independent animate are stored contiguously in it
+  // and interpolated in one pass per tick. Returns the offset of the added values.
+  std::size_t   addTracks(const std::vector<double>& from, const std::vector<double>& to);
+  const double* getTrackValues(std::size_t offset);
 
 public:
   const std::vector<std::shared_ptr<Animate>>& getChildAnimate();
@@ -109,28 +135,50 @@ private:
   std::shared_ptr<Interpolator>           m_interpolator;
   Animate*                                m_parent;
   std::vector<std::shared_ptr<Animate>>   m_childAnimates;
-  std::shared_ptr<Timer>                  m_timer;
+  bool                                    m_running{ false };
   std::optional<steady_clock::time_point> m_startTime;
   std::optional<steady_clock::time_point> m_lastTriggeredTime;
   std::vector<std::function<void()>>      m_callbackWhenStop;
+
+  // structure of arrays, used by independent animates only
+  std::vector<double> m_trackFrom;
+  std::vector<double> m_trackTo;
+  std::vector<double> m_trackNow;
+
+  void interpolateTracks();
+
+  // Called by AnimateManage for independent animations only.
+  void restartAt(steady_clock::time_point time);
+  void tick(steady_clock::time_point time);
 };
 
 class AnimateManage
 {
-  friend AttrBridge;
-
 public:
+  AnimateManage();
+  AnimateManage(const AnimateManage&) = delete;
+  AnimateManage& operator=(const AnimateManage&) = delete;
+
   // Returns whether some stopped animations has been removed.
   bool deleteFinishedAnimate();
 
   bool hasRunningAnimation() const;
 
-private:
+  AnimationClock& clock()
+  {
+    return m_clock;
+  }
+
   // if animate is not isIndependent, then do nothing.
   void addAnimate(std::shared_ptr<Animate> animate);
 
+private:
+  // Advance all running animations to `time`, called by m_clock.
+  void tick(steady_clock::time_point time);
+
 private:
   std::vector<std::shared_ptr<Animate>> m_animates;
+  AnimationClock                        m_clock;
 };
 
 class NumberAnimate : public Animate
@@ -159,8 +207,7 @@ private:
   void         setFromTo(const TParam& from, const TParam& to);
 
 private:
-  TParam                          m_from;
-  TParam                          m_to;
+  std::optional<std::size_t>      m_trackOffset; // in the tracks of the root animate
   TParam                          m_nowValue;
   std::vector<TTriggeredCallback> m_triggeredCallback;
 };
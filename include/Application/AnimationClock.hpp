@@ -0,0 +1,79 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+
+namespace VGG
+{
+
+class Timer;
+
+// The single time source of the animations of a view. Every tick hands one timestamp to all
+// running animations, so they stay in step with each other and with the rendered frames.
+class AnimationClock
+{
+public:
+  using TimePoint = std::chrono::steady_clock::time_point;
+  using TickCallback = std::function<void(TimePoint)>;
+
+  enum class EMode
+  {
+    FRAME,      // ticked by the render loop, once per rendered frame
+    FIXED_TICK, // ticks itself at a fixed interval while active, for headless use
+    MANUAL,     // advanced explicitly, deterministic, for tests and offline export
+  };
+
+  AnimationClock(TickCallback tickCallback);
+  ~AnimationClock();
+
+  EMode mode() const
+  {
+    return m_mode;
+  }
+  void setMode(EMode mode, std::chrono::milliseconds fixedInterval = std::chrono::milliseconds(16));
+
+  // Current time of the clock; in manual mode it only moves with advance().
+  TimePoint now() const;
+
+  // FRAME mode, sample the steady clock once and advance the animations with it.
+  void tick();
+  // MANUAL mode, step the time by `delta` and advance the animations with it.
+  void advance(std::chrono::milliseconds delta);
+
+  // Whether there is something to animate; the FIXED_TICK timer runs only while active.
+  void setActive(bool active);
+  bool isActive() const
+  {
+    return m_active;
+  }
+
+private:
+  EMode                     m_mode{ EMode::FRAME };
+  TickCallback              m_tickCallback;
+  TimePoint                 m_manualNow;
+  std::chrono::milliseconds m_fixedInterval{ 16 };
+  bool                      m_active{ false };
+  std::shared_ptr<Timer>    m_timer;
+
+  void notify(TimePoint time);
+  void updateTimer();
+};
+
+} // namespace VGG
@@ -75,6 +75,9 @@ public:                                       // configure
   void setEditMode(bool editMode);            // can be called before or after loading vgg file
   void setContentMode(
     const std::string& contentMode); // can be called before or after loading vgg file
+  // Binary snapshots of the parsed design, see Daruma::setSnapshotDir. Defaults to the
+  // VGG_SNAPSHOT_DIR environment variable, should be called before loading vgg file.
+  void setSnapshotDir(const std::string& dir);
 
 public:
   bool start(
@@ -150,6 +153,7 @@ private:
   void observeModelState();
   void observeViewEvent();
   void handleEvent(UIEventPtr evt);
+  void dropStaleEventHandlers();
 
   bool              hasContent() const;
   VGG::Layout::Size currentPageSize() const;
@@ -190,8 +194,9 @@ private:
   bool                       m_panning{ false };
 
   // configuration
-  bool     m_isFitToViewportEnabled{ true };
-  ERunMode m_mode;
+  bool        m_isFitToViewportEnabled{ true };
+  ERunMode    m_mode;
+  std::string m_snapshotDir;
 
   std::shared_ptr<Daruma> m_model;
   std::shared_ptr<Daruma> m_editModel;
@@ -200,6 +205,7 @@ private:
   std::shared_ptr<Layout::ExpandSymbol> m_expander;
 
   EventListener m_listener;
+  std::size_t   m_eventListenersRevision{ 0 }; // of m_model, seen by the js engine
 
   std::unique_ptr<LayoutContext> m_layoutContext;
   std::unique_ptr<Statistic>     m_statistic;
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Application/ElementUpdateProperty.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace VGG::app
+{
+
+// Packed, json free form of std::vector<ElementUpdateProperty> for high frequency updates.
+// Every command is `op, node, index, values...` in 32-bit words, `node` is a handle into nodeIds()
+// and `index` is the fill index (0 for element level properties). Float values are stored as their
+// bit pattern so the buffer can be filled through a Uint32Array/Float32Array pair from js or wasm.
+// Values are float32, enums and flags are stored as whole numbers: properties holding strings or
+// doubles, e.g. pattern image names and filters, stay with updateElement(items).
+class ElementUpdateBatch
+{
+public:
+  using Word = uint32_t;
+  using Handle = uint32_t;
+
+  enum class EOp : Word
+  {
+    FILL_BLEND_MODE,             // mode
+    FILL_COLOR,                  // a, r, g, b
+    FILL_ENABLED,                // enabled
+    FILL_OPACITY,                // opacity
+    PATTERN_IMAGE_FILL_ROTATION, // degree, effectOnFill
+    MATRIX,                      // a, b, c, d, tx, ty
+    OPACITY,                     // opacity
+    VISIBLE,                     // visible
+    SIZE,                        // width, height
+    COUNT
+  };
+
+  static constexpr std::size_t HEADER_SIZE = 3;
+  static std::size_t           valueCount(EOp op);
+
+  ElementUpdateBatch() = default;
+  ElementUpdateBatch(std::vector<std::string> nodeIds, std::vector<Word> words);
+  // Decodes the ISdk wire form, a trailing partial word is dropped.
+  ElementUpdateBatch(std::vector<std::string> nodeIds, const uint8_t* bytes, std::size_t size);
+
+  Handle node(const std::string& id); // same handle for the same id
+
+  void setFillBlendMode(Handle node, std::size_t index, int mode);
+  void setFillColor(Handle node, std::size_t index, float a, float r, float g, float b);
+  void setFillEnabled(Handle node, std::size_t index, bool enabled);
+  void setFillOpacity(Handle node, std::size_t index, float opacity);
+  void setPatternImageFillRotation(
+    Handle      node,
+    std::size_t index,
+    float       degree,
+    bool        effectOnFill);
+  void setMatrix(Handle node, float a, float b, float c, float d, float tx, float ty);
+  void setOpacity(Handle node, float opacity);
+  void setVisible(Handle node, bool visible);
+  void setSize(Handle node, float width, float height);
+
+  void clear();
+  bool empty() const
+  {
+    return m_words.empty();
+  }
+
+  const std::vector<std::string>& nodeIds() const
+  {
+    return m_nodeIds;
+  }
+  const std::vector<Word>& words() const
+  {
+    return m_words;
+  }
+  // The commands in the ISdk wire form
+  const uint8_t* bytes() const
+  {
+    return reinterpret_cast<const uint8_t*>(m_words.data());
+  }
+  std::size_t byteSize() const
+  {
+    return m_words.size() * sizeof(Word);
+  }
+
+  // Decodes the command at offset and advances offset past it. Returns false at the end of the
+  // buffer or on a malformed command, the rest of the buffer is not read in that case.
+  bool read(std::size_t& offset, Handle& outNode, ElementUpdateProperty& outProperty) const;
+
+  static Word  fromFloat(float value);
+  static float toFloat(Word word);
+
+private:
+  std::vector<std::string>                m_nodeIds;
+  std::vector<Word>                       m_words;
+  std::unordered_map<std::string, Handle> m_handles;
+
+  void append(EOp op, Handle node, std::size_t index, std::initializer_list<Word> values);
+};
+
+} // namespace VGG::app
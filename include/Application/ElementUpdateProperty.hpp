@@ -15,6 +15,9 @@
  */
 #pragma once
 
+#include "Domain/Model/DesignModel.hpp"
+
+#include <optional>
 #include <string>
 #include <variant>
 
@@ -17,7 +17,9 @@
 
 #include <chrono>
 #include <compare>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <rxcpp/operators/rx-observe_on.hpp>
 #include <rxcpp/schedulers/rx-runloop.hpp>
 
@@ -35,6 +37,9 @@ class RunLoop
   rxcpp::schedulers::run_loop m_runLoop;
 
 public:
+  using Clock = std::chrono::steady_clock;
+  using TimePoint = Clock::time_point;
+
   static std::shared_ptr<RunLoop> sharedInstance();
 
   rxcpp::observe_on_one_worker thread()
@@ -55,16 +60,36 @@ public:
     return m_runLoop.empty();
   }
 
-  void dispatch()
+  // Runs the due work (model events, timers, script callbacks) until `budget` is used up, the rest
+  // is left for the next call; at least one item runs per call. Returns whether due work is left.
+  // Input and paint, which ticks the frame clocked animations, are driven by the host loop directly
+  // and never wait behind this work.
+  bool dispatch(std::chrono::microseconds budget = std::chrono::microseconds::max());
+
+  // Called, on the thread that queues it, with the time work is due when it is queued before all
+  // the queued work; a host loop sleeping until nextDeadline() wakes up with it.
+  void setWakeUpHandler(std::function<void(const TimePoint&)> handler)
+  {
+    m_runLoop.set_notify_earlier_wakeup(std::move(handler));
+  }
+
+  // When the next work is due; nullopt if there is nothing queued.
+  std::optional<TimePoint> nextDeadline() const
   {
-    while (!m_runLoop.empty() && m_runLoop.peek().when < m_runLoop.now())
+    if (m_runLoop.empty())
     {
-      m_runLoop.dispatch();
+      return std::nullopt;
     }
+    return m_runLoop.peek().when;
   }
 
 private:
   RunLoop() = default;
+
+  bool hasDueWork() const
+  {
+    return !m_runLoop.empty() && m_runLoop.peek().when < m_runLoop.now();
+  }
 };
 
 } // namespace VGG
@@ -16,7 +16,9 @@
 #pragma once
 
 #include <stdint.h>
+#include <chrono>
 #include <memory>
+#include <optional>
 #include <vector>
 #include "Application/AppRender.hpp"
 #include "Application/Controller.hpp"
@@ -44,6 +46,11 @@ class UIApplication : public app::EventListener
 
   bool m_firstRender{ true };
 
+  std::chrono::nanoseconds              m_frameInterval{ 0 }; // 0 if the fps is not limited
+  std::chrono::steady_clock::time_point m_lastFrameStart;
+  uint64_t                              m_missedFrames{ 0 };
+  bool                                  m_frameWorkLeft{ false }; // after the last frame
+
 public:
   void setLayer(app::AppRender* layer);
   void setView(std::shared_ptr<UIScrollView> view, double w, double h);
@@ -59,9 +66,20 @@ public:
 
   bool onEvent(UEvent evt, void* userData) override;
 
-  bool needsPaint();
+  bool needsPaint(); // also while an animation clock in FRAME mode is active
   bool paint(int fps, bool force = false);
 
+  // Frame scheduling for the host loop.
+  // The time paint or the run loop has work to do next, nullopt if only an event can bring some.
+  std::optional<std::chrono::steady_clock::time_point> nextWakeUp();
+  // The time the run loop may spend before the next frame is due.
+  std::chrono::microseconds frameBudget();
+  // Frame intervals that passed before a due frame was drawn, the first frame included.
+  uint64_t missedFrames() const
+  {
+    return m_missedFrames;
+  }
+
   std::vector<uint8_t> makeImageSnapshot(layer::ImageOptions options);
 
 private:
@@ -29,6 +29,7 @@
 #include "Application/ElementAddProperty.hpp"
 #include "Application/ElementDeleteProperty.hpp"
 #include "Application/ElementGetProperty.hpp"
+#include "Application/ElementUpdateBatch.hpp"
 #include "Application/ElementUpdateProperty.hpp"
 #include "Application/Event/EventListener.hpp"
 #include "Application/UIAnimation.hpp"
@@ -42,6 +43,7 @@
 #include "glm/ext/vector_float2.hpp"
 namespace VGG
 {
+class AnimationClock;
 class LayoutNode;
 class StateTree;
 namespace app
@@ -132,12 +134,18 @@ private:
   bool m_drawGrayBackground{ false };
 
   std::optional<UEvent> m_lastMouseMove; // Used to trigger mouseenter event when content is updated
+  std::optional<UEvent> m_pendingMouseMove; // motion events coalesced until the next loop
+
+  struct HitPathCache;
+  std::unique_ptr<HitPathCache> m_hitPathCache; // shared by all the types of one mouse event
 
 public:
   UIView();
   ~UIView();
 
   void frame();
+  // Drives the animations of the view, ticked by the render loop before each frame by default.
+  AnimationClock& animationClock();
 
   void show(
     std::shared_ptr<ViewModel>&                viewModel,
@@ -201,10 +209,7 @@ public:
     m_isDirty = dirty;
   }
 
-  void updateOncePerLoop()
-  {
-    m_skipUntilNextLoop = false;
-  }
+  void updateOncePerLoop();
 
   int currentPageIndex();
 
@@ -263,6 +268,7 @@ public:
   int updateElement(
     const std::vector<app::ElementUpdateProperty>& items,
     const app::UIAnimationOption&                  option);
+  int updateElement(const app::ElementUpdateBatch& batch, const app::UIAnimationOption& option);
   std::optional<app::ElementProperty> getElementProperty(const app::ElementGetProperty& query);
   bool                                addElementProperty(const app::ElementAddProperty& command);
   bool deleteElementProperty(const app::ElementDeleteProperty& command);
@@ -289,6 +295,8 @@ private:
   const std::string           pageIdByIndex(std::size_t index);
 
   void onMouseMove(UEvent evt, bool forHover = false);
+  void coalesceMouseMove(const UEvent& evt);
+  void flushMouseMove();
   bool handleMouseEvent(
     int          jsButtonIndex,
     int          x,
@@ -70,6 +70,17 @@ public:
   void        updateElement(const std::string& id, const std::string& contentJsonString) override;
   int         updateElementProperties(const std::string& updates, const AnimationOptions& animation)
     override;
+  int         updateElementPropertiesBatch(
+    const std::vector<std::string>& nodeIds,
+    const uint8_t*                  commands,
+    std::size_t                     size,
+    const AnimationOptions&         animation) override;
+#ifdef EMSCRIPTEN
+  int jsUpdateElementPropertiesBatch(
+    const emscripten::val&  nodeIds,
+    const emscripten::val&  words,
+    const AnimationOptions& animation);
+#endif
   std::string getElementProperty(const std::string& query) override;
   bool        addElementProperty(const std::string& command) override;
   bool        deleteElementProperty(const std::string& command) override;
@@ -134,6 +145,9 @@ public:
   emscripten::val emMakeImageSnapshot(const ImageOptions& options);
 #endif
 
+  void        setTracingEnabled(bool enabled) override;
+  std::string chromeTrace() override;
+
   void openUrl(const std::string& url, const std::string& target) override;
 
   // event listener
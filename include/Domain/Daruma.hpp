@@ -40,6 +40,9 @@ class Element;
 } // namespace Domain
 namespace Model
 {
+struct DesignModel;
+class SnapshotCache;
+class EventListenerTable;
 class Visitor;
 namespace Detail
 {
@@ -61,14 +64,24 @@ class Daruma
 
   std::unordered_map<std::string, std::string> m_memoryCode; // fileName: code_content
   nlohmann::json                               m_eventListeners;
+  std::size_t                                  m_eventListenersRevision{ 0 };
+
+  // rebuilt from m_eventListeners when the listeners change, the mutex guards the pointer only
+  std::shared_ptr<const Model::EventListenerTable> m_eventListenerTable;
+  std::mutex                                       m_eventListenerTableMutex;
+  // fileName: code, shared by the tables
+  std::unordered_map<std::string, std::shared_ptr<const std::string>> m_listenerCode;
 
   // original model
-  JsonDocumentPtr              m_designDoc;
-  MakeJsonDocFn                m_makeDesignDocFn;
-  JsonDocumentPtr              m_layoutDoc;
-  MakeJsonDocFn                m_makeLayoutDocFn;
-  Model::Loader::ResourcesType m_resources;
-  nlohmann::json               m_settingsDoc;
+  JsonDocumentPtr                       m_designDoc;   // serialized from m_designModel when used
+  std::shared_ptr<Model::DesignModel>   m_designModel; // streamed while loading, null once used
+  std::mutex                            m_designDocMutex; // guards m_designDoc and m_designModel
+  std::unique_ptr<Model::SnapshotCache> m_snapshotCache;
+  MakeJsonDocFn                         m_makeDesignDocFn;
+  JsonDocumentPtr                       m_layoutDoc;
+  MakeJsonDocFn                         m_makeLayoutDocFn;
+  Model::Loader::ResourcesType          m_resources;
+  nlohmann::json                        m_settingsDoc;
 
   // runtime view model, symbol instance expanded
   std::shared_ptr<Domain::DesignDocument> m_designDocTree;
@@ -84,6 +97,10 @@ public:
   Daruma(const MakeJsonDocFn& makeDesignDocFn, const MakeJsonDocFn& makeLayoutDocFn = {});
   ~Daruma();
 
+  // Cache parsed design models as binary snapshots in `dir`, keyed by the content of design.json.
+  // Must be called before load, empty to disable.
+  void setSnapshotDir(const std::string& dir);
+
   bool load(const std::string& path);   // zip file or dir
   bool load(std::vector<char>& buffer); // zip buffer
 
@@ -94,7 +111,12 @@ public:
   void            setRuntimeDesignDocTree(std::shared_ptr<Domain::DesignDocument> designDocTree);
   void            setRuntimeLayoutDoc(const nlohmann::json& layoutJson);
 
+  // Serialized from the typed model on first use, which is released then: edits are made to the
+  // json document from that point on.
   JsonDocumentPtr& designDoc();
+  // The typed model parsed while loading, null once designDoc() has been built. Cheaper than
+  // converting designDoc().
+  std::shared_ptr<Model::DesignModel> designModel();
   JsonDocumentPtr& layoutDoc();
   auto             resources()
   {
@@ -127,6 +149,10 @@ public: // event listener
     const std::string& type,
     const std::string& code);
   auto getEventListeners(const std::string& targetKey) -> ListenersType;
+  // Snapshot of all listeners, never nullptr. Cheap to call for every event.
+  std::shared_ptr<const Model::EventListenerTable> eventListenerTable();
+  // Changes when listener code is removed or reloaded; handlers compiled before are stale
+  std::size_t eventListenersRevision();
 
   // todo, make sure the wasm files (*.mjs *.wasm) are in the correct directory or url
 
@@ -135,9 +161,11 @@ public:
   rxcpp::observable<VGG::ModelEventPtr> getObservable();
 
 private:
-  bool loadFiles();
+  bool                                loadFiles();
+  std::unique_ptr<Model::DesignModel> loadDesignModel(const std::string& fileContent);
 
   std::string getCode(const std::string& fileName);
+  void        rebuildEventListenerTable();
 
   std::string uuidFor(const std::string& content);
 
@@ -70,6 +70,9 @@ public:
   ExpandSymbol(
     const nlohmann::json& designJson,
     const nlohmann::json& layoutJson = nlohmann::json());
+  ExpandSymbol( // shares the model parsed while loading, no json to model conversion
+    std::shared_ptr<Model::DesignModel> designModel,
+    const nlohmann::json&               layoutJson = nlohmann::json());
   ~ExpandSymbol();
 
   std::pair<std::shared_ptr<VGG::Domain::DesignDocument>, nlohmann::json>
@@ -99,8 +102,8 @@ private:
   void collectLayoutRules(const nlohmann::json& json);
 
   void traverseElementNode(
-    std::shared_ptr<Domain::Element>& element,
-    std::vector<std::string>&         instanceIdStack);
+    const std::shared_ptr<Domain::Element>& element,
+    std::vector<std::string>&               instanceIdStack);
   void expandInstanceElement(
     Domain::SymbolInstanceElement& instance,
     std::vector<std::string>&      instanceIdStack,
@@ -178,7 +181,7 @@ private:
   void resetInstanceInfo(Domain::SymbolInstanceElement& instance);
 
 private:
-  const std::unique_ptr<Model::DesignModel>                   m_designModel;
+  const std::shared_ptr<Model::DesignModel>                   m_designModel;
   const nlohmann::json                                        m_layoutJson;
   std::unordered_map<std::string, nlohmann::json>             m_outLayoutJsonMap; // performance
   RuleMapPtr                                                  m_layoutRulesCache; // performance
@@ -0,0 +1,33 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <unordered_set>
+#include <nlohmann/json.hpp>
+
+namespace VGG::Layout
+{
+
+// The design document reduced to the frames with the given ids and the frames and references that
+// hold the masters they use, directly or through other masters, so that expanding and laying out
+// a few frames does not pay for the whole document. The order of the frames is kept.
+nlohmann::json selectFrames(
+  const nlohmann::json&                  designDoc,
+  const std::unordered_set<std::string>& frameIds);
+
+} // namespace VGG::Layout
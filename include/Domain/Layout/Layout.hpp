@@ -54,7 +54,10 @@ private:
   RuleMapPtr                              m_rules;
   std::vector<Size>                       m_originalPageSize;
 
-  std::unordered_map<std::string, LayoutNode*> m_nodeCacheMap; // id: node
+  std::unordered_map<std::string, LayoutNode*>       m_nodeCacheMap;  // id: node
+  std::unordered_map<const LayoutNode*, std::string> m_nodeCacheKeys; // node: cached id
+
+  std::shared_ptr<FrameChangeReport> m_frameChangeReport;
 
 public:
   Layout(JsonDocumentPtr designDoc, JsonDocumentPtr layoutDoc);
@@ -66,6 +69,11 @@ public:
   void resizeNodeThenLayout(LayoutNode* node, Size size, bool preservingOrigin);
   void layoutNodes(const std::vector<std::string>& nodeIds, const std::string& constainerNodeId);
 
+  // Frame diff report of the layout passes run by layout, resizeNodeThenLayout and layoutNodes,
+  // disabled by default
+  void setFrameChangeReportEnabled(bool enabled);
+  std::vector<std::weak_ptr<LayoutNode>> takeChangedNodes(); // frame changed since last take
+
   void rebuildSubtree(LayoutNode* node);
   void rebuildSubtreeById(std::string nodeId);
 
@@ -104,6 +112,9 @@ private:
   void configureNodeAutoLayout(LayoutNode* node, bool createAutoLayout = true);
 
   void updateFirstOnTop(std::shared_ptr<Domain::Element> element);
+
+  void uncacheOneNode(LayoutNode* node);
+  void primeNodeCache(LayoutNode* tree);
 };
 
 } // namespace Layout
@@ -22,6 +22,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include "Domain/Layout/Rect.hpp"
@@ -29,6 +30,7 @@
 namespace VGG
 {
 class LayoutContext;
+class LayoutNode;
 namespace Layout
 {
 struct BezierPoint;
@@ -43,6 +45,49 @@ class AutoLayout;
 namespace VGG
 {
 
+// Nodes whose frame changed, recorded during the layout passes it is set up for.
+class FrameChangeReport
+{
+  std::vector<std::weak_ptr<LayoutNode>> m_nodes;
+  std::unordered_set<const LayoutNode*>  m_added;
+
+  static thread_local FrameChangeReport* s_recording;
+
+public:
+  // Records the frame changes made on this thread while alive into report, set once per layout
+  // pass so that setFrame does not look the report up in the tree. Does nothing for nullptr.
+  class Recording
+  {
+    FrameChangeReport* m_previous;
+
+  public:
+    explicit Recording(FrameChangeReport* report)
+      : m_previous{ s_recording }
+    {
+      if (report)
+        s_recording = report;
+    }
+    ~Recording()
+    {
+      s_recording = m_previous;
+    }
+    Recording(const Recording&) = delete;
+    Recording& operator=(const Recording&) = delete;
+  };
+
+  static FrameChangeReport* recording()
+  {
+    return s_recording;
+  }
+
+  void add(LayoutNode* node);
+  bool empty() const
+  {
+    return m_nodes.empty();
+  }
+  std::vector<std::weak_ptr<LayoutNode>> take(); // in the order of the first change, no duplicates
+};
+
 class LayoutNode : public std::enable_shared_from_this<LayoutNode>
 {
   enum class EResizing
@@ -77,6 +122,11 @@ class LayoutNode : public std::enable_shared_from_this<LayoutNode>
 
   bool m_needsLayoutText = false;
 
+  // self or some descendant needs layout, set up to the root when marked, layoutIfNeeded only
+  // visits the flagged subtrees
+  bool m_descendantNeedsLayout{ false };
+  bool m_descendantNeedsLayoutText{ false };
+
   std::optional<Layout::Scalar> m_rightMargin;
   std::optional<Layout::Scalar> m_fixStartWidthRatio;
   std::optional<Layout::Scalar> m_fixEndWidthRatio;
@@ -119,6 +169,20 @@ public:
   std::pair<std::shared_ptr<LayoutNode>, std::string> hitTest(
     const Layout::Point& point,
     const HitTestHook&   hasEventListener);
+
+  // Every node that hitTest would check for listeners at the point, in hitTest order. Query it with
+  // the static hitTest below to get the same result as hitTest(point, hook) without walking the
+  // tree again.
+  struct HitPathEntry
+  {
+    std::shared_ptr<LayoutNode> node;
+    std::vector<std::string>    keys;
+  };
+  using HitPath = std::vector<HitPathEntry>;
+  void hitTestPath(const Layout::Point& point, HitPath& outPath);
+  static std::pair<std::shared_ptr<LayoutNode>, std::string> hitTest(
+    const HitPath&     path,
+    const HitTestHook& hasEventListener);
   virtual bool shouldHandleEvents() const
   {
     return true;
@@ -133,6 +197,11 @@ public:
 
     child->m_parent = weak_from_this();
     m_children.push_back(child);
+
+    if (child->m_descendantNeedsLayout)
+      propagate(&LayoutNode::m_descendantNeedsLayout);
+    if (child->m_descendantNeedsLayoutText)
+      propagate(&LayoutNode::m_descendantNeedsLayoutText);
   }
 
   void removeChild(std::shared_ptr<LayoutNode> child)
@@ -182,7 +251,10 @@ public:
   {
     return m_needsLayout;
   }
-  bool hasNeedsLayoutDescendant() const;
+  bool hasNeedsLayoutDescendant() const // self included, may stay true until next layoutIfNeeded
+  {
+    return m_descendantNeedsLayout;
+  }
   void layoutIfNeeded(LayoutContext* context = nullptr);
 
   std::shared_ptr<LayoutNode> scaleTo(
@@ -226,6 +298,8 @@ private:
   bool isVectorNetwork() const;
   bool isVectorNetworkDescendant() const;
 
+  std::vector<std::string> eventListenerKeys() const; // keys to look up listeners of this node
+
   Layout::Rect convertRectToAncestor(
     Layout::Rect                rect,
     std::shared_ptr<LayoutNode> ancestorNode = nullptr)
@@ -305,6 +379,8 @@ private:
   LayoutContext* context();
 
   void updateTextLayoutInfo();
+  void setNeedsLayoutText();
+  void propagate(bool LayoutNode::*flag); // set flag on self and ancestors
 
 private:
   LayoutContext* m_context = nullptr;
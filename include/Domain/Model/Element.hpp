@@ -26,6 +26,7 @@
 #include "Domain/Layout/Math.hpp"
 #include "Domain/Layout/Rect.hpp"
 #include "Domain/Model/DesignModel.hpp"
+#include "Domain/Model/ElementIndex.hpp"
 #include <nlohmann/json.hpp>
 namespace VGG
 {
@@ -113,6 +114,21 @@ public:
     return m_children;
   }
 
+  template<typename F>
+  void forEachChild(F&& f, bool reverseChildrenIfFirstOnTop = false) const
+  {
+    if (reverseChildrenIfFirstOnTop && isFirstOnTop())
+    {
+      for (auto it = m_children.rbegin(); it != m_children.rend(); ++it)
+        f(*it);
+    }
+    else
+    {
+      for (auto& child : m_children)
+        f(child);
+    }
+  }
+
   auto begin() const noexcept
   {
     return m_children.begin();
@@ -162,6 +178,9 @@ public:
 
   virtual std::shared_ptr<Element> getElementByKey(const std::string& key); // name or id
 
+  ElementIndex* documentIndex() const; // nullptr if not attached to a design document
+  void          reindex();             // call after the id, name or override key changed
+
 public: // Getters, Setters
   void setVisible(bool visible);
 
@@ -175,21 +194,12 @@ public: // Getters, Setters
   }
 
 public:
-  void addChild(std::shared_ptr<Element> child)
-  {
-    if (!child)
-    {
-      return;
-    }
+  void addChild(std::shared_ptr<Element> child);
+  void removeChild(const std::shared_ptr<Element>& child);
 
-    child->m_parent = weak_from_this();
-    m_children.push_back(child);
-  }
-
-  auto clearChildren()
-  {
-    return std::move(m_children);
-  }
+  // The returned children are detached like removeChild does: their parent links are cleared, so
+  // later edits of the old subtrees cannot reach the index of the document.
+  std::vector<std::shared_ptr<Element>> clearChildren();
 
   virtual void buildSubtree()
   {
@@ -230,6 +240,11 @@ public:
   void addSubGeometry(const Model::SubGeometryType& subGeometry);
 
 private:
+  std::shared_ptr<Element> findElementByKey(
+    const std::vector<std::string>& keyStack,
+    const std::string&              firstObjectId,
+    std::vector<std::string>*       outInstanceIdStack);
+
   void applyOverrides(
     nlohmann::json&           json,
     std::string               name,
@@ -242,6 +257,7 @@ private:
 class DesignDocument : public Element
 {
   std::shared_ptr<Model::DesignModel> m_designModel;
+  std::unique_ptr<ElementIndex>       m_index;
 
 public:
   DesignDocument(const Model::DesignModel& designModel);
@@ -252,6 +268,12 @@ public:
     bool reverseChildrenIfFirstOnTop = false) const; // build the tree model
 
   std::shared_ptr<Element> getElementByKey(const std::string& key) override;
+  std::shared_ptr<Element> getElementByIdNumber(int idNumber) const;
+
+  ElementIndex* index() const
+  {
+    return m_index.get();
+  }
 
   std::shared_ptr<Model::DesignModel> designModel() const
   {
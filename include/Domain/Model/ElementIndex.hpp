@@ -0,0 +1,91 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace VGG
+{
+namespace Domain
+{
+class Element;
+
+// Hash index of the elements attached to a design document.
+// The index is maintained by Element::addChild/removeChild/clearChildren/addKeyPrefix/regenerateId,
+// lookups are restricted to a subtree by walking up the parent chain of the candidates.
+class ElementIndex
+{
+public:
+  enum class EResult
+  {
+    NOT_FOUND,
+    FOUND,
+    AMBIGUOUS, // more than one candidate in scope, caller should fall back to tree order scan
+  };
+
+  void add(Element* tree);
+  void remove(Element* tree);
+  void reindex(Element* element); // keys of the element changed
+  void clear();
+
+  // id or name
+  EResult findByIdOrName(const std::string& key, const Element* scope, Element*& outElement);
+  // overrideKey or id
+  EResult findByKey(const std::string& key, const Element* scope, Element*& outElement);
+
+  Element*    findByIdNumber(int idNumber) const;
+  std::size_t size() const
+  {
+    return m_keys.size();
+  }
+
+private:
+  using Map = std::unordered_multimap<std::string, Element*>;
+
+  struct Keys
+  {
+    std::string                id;
+    std::optional<std::string> name;
+    std::optional<std::string> overrideKey;
+    int                        idNumber{ 0 };
+  };
+
+  std::unordered_map<const Element*, Keys> m_keys; // element: indexed keys
+  Map                                      m_ids;
+  Map                                      m_names;
+  Map                                      m_overrideKeys;
+  std::unordered_map<int, Element*>        m_idNumbers;
+
+  void addOne(Element* element);
+  void removeOne(const Element* element);
+
+  void    collect(const Map& map, const std::string& key, std::vector<Element*>& outCandidates);
+  EResult pick(
+    const std::string&     key,
+    std::vector<Element*>& candidates,
+    const Element*         scope,
+    Element*&              outElement);
+  bool isValid(const Element* element, const std::string& key) const;
+
+  static void eraseFrom(Map& map, const std::string& key, const Element* element);
+};
+
+} // namespace Domain
+} // namespace VGG
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace VGG
+{
+namespace Model
+{
+
+// Immutable (target key, event type) -> listener code index. Daruma builds a new table whenever
+// the listeners change and readers keep the table they got, so dispatching an event costs two hash
+// lookups no matter how many listeners or how much script the document has.
+class EventListenerTable
+{
+public:
+  using Code = std::shared_ptr<const std::string>;
+  struct Listener
+  {
+    std::string fileName; // content hash of the code for added listeners, identifies the handler
+    Code        code;
+  };
+  using Listeners = std::vector<Listener>;
+  using TypeListeners = std::unordered_map<std::string, Listeners>; // type: listeners
+  using CodeForFileName = std::function<Code(const std::string& fileName)>;
+
+  EventListenerTable() = default;
+  // eventListeners: content of the event listeners file, {targetKey: {type: [{fileName}]}}
+  EventListenerTable(const nlohmann::json& eventListeners, const CodeForFileName& codeFor);
+
+  const TypeListeners* find(const std::string& targetKey) const;
+  const Listeners*     find(const std::string& targetKey, const std::string& type) const;
+  bool                 has(const std::string& targetKey, const std::string& type) const
+  {
+    return find(targetKey, type);
+  }
+
+private:
+  std::unordered_map<std::string, TypeListeners> m_listeners; // targetKey: listeners
+};
+
+} // namespace Model
+} // namespace VGG
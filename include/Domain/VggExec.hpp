@@ -36,7 +36,9 @@ public:
 
   bool evalScript(const std::string& script);
   bool evalModule(const std::string& script);
-  bool evalModule(const std::string& code, VGG::EventPtr event);
+  bool evalModule(const std::string& handlerKey, const std::string& code, VGG::EventPtr event);
+  void clearModuleCache();
+  bool postEvent(const std::string& event, const std::string& coalesceKey = {});
 
   void openUrl(const std::string& url, const std::string& target);
 
@@ -32,10 +32,23 @@ public:
 
   virtual bool evalScript(const std::string& code) = 0;
   virtual bool evalModule(const std::string& code) = 0;
+  // Call the default export of the module `code` with `event`. `handlerKey` names the code, it is
+  // the listener file name; engines may keep the handler by key and skip `code` on later calls
+  // while it is unchanged, another document may use the same name for other code.
   virtual bool evalModule(
+    const std::string&       handlerKey,
     const std::string&       code,
     VGG::EventPtr            event,
     std::shared_ptr<IVggEnv> env) = 0;
+  // Drop compiled event handlers kept by evalModule(handlerKey, code, event, env)
+  virtual void clearModuleCache() = 0;
+  // Deliver the json `event` to the js listener globalThis[containerKey][envKey][listenerKey] of
+  // `env`. Engines may deliver events in batches, a pending event is replaced by a later one with
+  // the same non empty `coalesceKey`.
+  virtual bool postEvent(
+    const std::string&       event,
+    const std::string&       coalesceKey,
+    std::shared_ptr<IVggEnv> env) = 0;
 
   virtual void openUrl(const std::string& url, const std::string& target) = 0;
 };
@@ -18,7 +18,10 @@
 
 #include "Layer/Core/RenderNode.hpp"
 
-#include <queue>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace VGG::layer
 {
@@ -34,21 +37,25 @@ struct Event
   ENodeEvent     event;
 };
 
+// Node invalidation queue.
+// postEvent can be called from any thread, a node is queued at most once until it is polled.
+// pollEvents must be called on the render thread, it drains the queue in tree order (observers
+// before the nodes they observe) so that each ancestor is invalidated once per drain.
 class EventManager
 {
 public:
-  static void postEvent(Event e)
-  {
-    sharedInstance().m_eventQueue.push(e);
-  }
+  static void postEvent(Event e);
 
   static void pollEvents();
 
   static bool hasEvents()
   {
-    return !sharedInstance().m_eventQueue.empty();
+    return sharedInstance().m_hasEvents.load(std::memory_order_acquire);
   }
 
+  // Number of queued events, for diagnostics.
+  static std::size_t pendingEvents();
+
   EventManager(const EventManager&) = delete;
   EventManager(EventManager&&) = delete;
   EventManager& operator=(const EventManager&) = delete;
@@ -61,6 +68,10 @@ private:
     static EventManager s_sharedInstance;
     return s_sharedInstance;
   }
-  std::queue<Event> m_eventQueue;
+  static int depth(VNode* node, std::unordered_map<VNode*, int>& cache);
+
+  std::mutex         m_mutex;
+  std::vector<Event> m_eventQueue;
+  std::atomic_bool   m_hasEvents{ false };
 };
 } // namespace VGG::layer
@@ -30,6 +30,7 @@
 #include <memory>
 #include <vector>
 #include <algorithm>
+#include <atomic>
 #include <queue>
 
 #define VGG_CLASS_MAKE(className)                                                                  \
@@ -102,7 +103,6 @@ protected:
     INVALIDATE = 1 << 0,   // node is invalid
     DAMAGE = 1 << 1,       // node is damaged, need to be redraw if necessary
     TRAVERSALING = 1 << 2, // node is traversaling, avoid reentrant
-    UPDATE = 1 << 3,       // some events are sent to the internal event queue.
   };
   using EStateT = uint8_t;
 
@@ -125,6 +125,21 @@ public:
 
   void update();
 
+  // Defers the invalidations made on this thread while alive, then invalidates each node once, so
+  // setting many attributes of a node walks its observers once. Batches may nest, the outermost
+  // one invalidates. Nothing may revalidate the deferred nodes in the meantime.
+  class InvalidationBatch
+  {
+  public:
+    InvalidationBatch();
+    ~InvalidationBatch();
+    InvalidationBatch(const InvalidationBatch&) = delete;
+    InvalidationBatch& operator=(const InvalidationBatch&) = delete;
+
+  private:
+    bool m_outermost;
+  };
+
   const Bounds& revalidate(Revalidation* inv = nullptr, const glm::mat3& ctm = glm::mat3(1.0f));
 
   const Bounds& bounds() const
@@ -161,6 +176,7 @@ private:
   uint8_t               m_state : 4 { 0 };
   const EDamageTrait    m_trait : 2 { 0 };
   std::vector<VNodeRef> m_observers;
+  std::atomic_bool      m_queued{ false }; // set while an event is in EventManager's queue
 
   template<typename Visitor>
   void visitObservers(Visitor&& v)
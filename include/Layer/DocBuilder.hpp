@@ -19,6 +19,7 @@
 #include "Layer/Core/Timer.hpp"
 #include "Domain/JsonDocument.hpp"
 #include "Domain/Layout/ExpandSymbol.hpp"
+#include "Domain/Layout/FrameSubset.hpp"
 #include "Domain/Layout/Layout.hpp"
 #include "Domain/RawJsonDocument.hpp"
 
@@ -26,6 +27,8 @@
 #include <nlohmann/json.hpp>
 #include <Utility/Log.hpp>
 #include <optional>
+#include <string>
+#include <unordered_set>
 
 #define SET_BUILDER_OPTION(container, attr)                                                        \
   ASSERT(!this->m_invalid);                                                                        \
@@ -45,6 +48,8 @@ class DocBuilder
   Model::DesignModel m_docModel;
   bool               m_invalid{ false };
 
+  std::unordered_set<std::string> m_frameIds; // empty for all frames
+
   void moveToThis(DocBuilder&& that) noexcept
   {
     ASSERT(!that.m_invalid);
@@ -53,6 +58,7 @@ class DocBuilder
     m_layout = std::move(that.m_layout);
     m_doc = std::move(that.m_doc);
     m_docModel = std::move(that.m_docModel);
+    m_frameIds = std::move(that.m_frameIds);
     m_invalid = std::move(that.m_invalid);
     that.m_invalid = true;
   }
@@ -117,11 +123,20 @@ public:
   {
     SET_BUILDER_OPTION(m_enableLayout, enabled);
   }
+  // Builds the given frames and the masters they use only
+  DocBuilder setFrameFilter(std::unordered_set<std::string> frameIds)
+  {
+    SET_BUILDER_OPTION(m_frameIds, frameIds);
+  }
 
   Result build()
   {
     ASSERT(!m_invalid);
     Result::TimeCost cost;
+    if (!m_frameIds.empty())
+    {
+      m_doc = Layout::selectFrames(m_doc, m_frameIds);
+    }
     if (m_enableExpand)
     {
       auto d = std::shared_ptr<VGG::Domain::DesignDocument>();
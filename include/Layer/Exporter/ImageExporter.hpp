@@ -22,8 +22,32 @@
 
 #include <core/SkSurface.h>
 #include <core/SkCanvas.h>
+#include <core/SkImage.h>
 
 namespace VGG::layer::exporter
 {
 std::optional<std::vector<char>> makeImage(const ImageOptions& opts, SkSurface* surface);
+
+// Raw pixels in the format of opts, read straight into dst whose rows are rowBytes apart.
+SkImageInfo rawImageInfo(const ImageOptions& opts);
+
+bool readPixels(const ImageOptions& opts, SkSurface* surface, void* dst, std::size_t rowBytes);
+bool readPixels(const ImageOptions& opts, SkImage* image, void* dst, std::size_t rowBytes);
+
+// makeImage in two steps: the snapshot is cpu backed, so that it can be encoded on any thread
+// while the surface is reused.
+sk_sp<SkImage>                   makeSnapshot(const ImageOptions& opts, SkSurface* surface);
+std::optional<std::vector<char>> encodeSnapshot(const ImageOptions& opts, SkImage* image);
+
+// What the encoder profiles look at before picking a format variant.
+constexpr std::size_t MAX_PALETTE_COLORS = 256;
+struct ColorStats
+{
+  bool        opaque{ true };
+  bool        gray{ true };
+  std::size_t colorCount{ 0 }; // stops counting past MAX_PALETTE_COLORS
+};
+
+// 8888 pixmaps only, the palette (0xRRGGBB) is filled when it fits in MAX_PALETTE_COLORS.
+ColorStats analyzeColors(const SkPixmap& pixmap, std::vector<uint32_t>* palette = nullptr);
 } // namespace VGG::layer::exporter
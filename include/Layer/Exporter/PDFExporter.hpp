@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #pragma once
+#include <functional>
+#include <memory>
 #include <vector>
 #include <optional>
 #include <ostream>
@@ -33,6 +35,27 @@ struct PDFOptions
   int position[2];
   int extend[2];
 };
+// Receives the document as it is written, returns false to abort
+using WriteProc = std::function<bool(const char* data, std::size_t size)>;
+
 std::optional<std::vector<char>> makePDF(layer::FrameNode* frame, const PDFOptions& opts);
 void makePDF(layer::FrameNode* frame, const PDFOptions& opts, std::ostream& os);
+bool makePDF(layer::FrameNode* frame, const PDFOptions& opts, const WriteProc& write);
+
+// One PDF with a page per frame, written as the pages are added. Fonts and images used by more
+// than one page are embedded once.
+class PDFDocument
+{
+  struct Impl;
+  std::unique_ptr<Impl> d_impl; // NOLINT
+
+public:
+  PDFDocument(WriteProc write);
+  PDFDocument(const PDFDocument&) = delete;
+  PDFDocument& operator=(const PDFDocument&) = delete;
+  ~PDFDocument(); // closes the document if it is still open
+
+  bool addPage(layer::FrameNode* frame, const PDFOptions& opts);
+  bool close();
+};
 } // namespace VGG::layer::exporter
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #pragma once
+#include <functional>
 #include <vector>
 #include <optional>
 #include <ostream>
@@ -28,6 +29,9 @@ class FrameNode;
 }
 namespace VGG::layer::exporter
 {
+// Receives the document as it is written, returns false to abort
+using WriteProc = std::function<bool(const char* data, std::size_t size)>;
+
 struct SVGOptions
 {
   int position[2];
@@ -36,4 +40,5 @@ struct SVGOptions
 
 std::optional<std::vector<char>> makeSVG(VGG::layer::FrameNode* frame, const SVGOptions& opts);
 void makeSVG(VGG::layer::FrameNode* frame, const SVGOptions& opts, std::ostream& os);
+bool makeSVG(VGG::layer::FrameNode* frame, const SVGOptions& opts, const WriteProc& write);
 } // namespace VGG::layer::exporter
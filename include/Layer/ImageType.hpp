@@ -25,11 +25,31 @@ enum class EImageEncode
   IE_RAW
 };
 
+enum class EPixelFormat
+{
+  RGBA_8888,
+  BGRA_8888
+};
+
+// Trades encoding time against output size, DEFAULT keeps the settings derived from quality.
+enum class EEncodeProfile
+{
+  DEFAULT,
+  FAST,     // fastest deflate, no filter search
+  BALANCED, // lossless webp for flat content, full chroma jpeg at high quality
+  SMALLEST  // maximum effort, grayscale png for gray content
+};
+
 struct ImageOptions
 {
-  EImageEncode encode;
-  int          position[2] = { 0, 0 };
-  int          extend[2] = { 0, 0 };
-  int          quality{ 100 };
+  EImageEncode   encode;
+  int            position[2] = { 0, 0 };
+  int            extend[2] = { 0, 0 };
+  int            quality{ 100 };
+  EEncodeProfile profile{ EEncodeProfile::DEFAULT };
+
+  // IE_RAW only
+  EPixelFormat   pixelFormat{ EPixelFormat::RGBA_8888 };
+  bool           premultiplied{ false };
 };
 } // namespace VGG::layer
@@ -0,0 +1,138 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace VGG
+{
+
+// Lightweight frame tracing, always compiled and off by default.
+// Zones and per-frame counters are kept in a ring buffer which can be dumped as Chrome trace JSON
+// (chrome://tracing, ui.perfetto.dev). When disabled a zone costs one relaxed atomic load. It is
+// switched by ISdk::setTracingEnabled or by the VGG_TRACE environment variable at startup.
+class Tracer
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  enum class ECounter
+  {
+    TILES_RASTERED,
+    CACHE_HITS,
+    NODES_REVALIDATED,
+    NODES_INVALIDATED,
+    PARAGRAPHS_SHAPED,
+    COUNT
+  };
+
+  static Tracer& sharedInstance();
+
+  bool enabled() const
+  {
+    return m_enabled.load(std::memory_order_relaxed);
+  }
+  void setEnabled(bool enabled);
+
+  // Number of events kept, the oldest ones are overwritten.
+  void setCapacity(std::size_t capacity);
+  void clear();
+
+  // `name` must outlive the tracer, usually a string literal.
+  void addZone(const char* name, Clock::time_point begin, Clock::time_point end);
+  void addCounter(ECounter counter, int64_t delta = 1)
+  {
+    if (enabled())
+    {
+      m_counters[std::size_t(counter)].fetch_add(delta, std::memory_order_relaxed);
+    }
+  }
+
+  // Records the counters of the finished frame and resets them.
+  void markFrame();
+
+  std::string dumpChromeTrace() const;
+
+  Tracer(const Tracer&) = delete;
+  Tracer& operator=(const Tracer&) = delete;
+
+private:
+  struct Event
+  {
+    const char* name{ nullptr }; // nullptr for a frame counters event
+    uint32_t    threadId{ 0 };
+    int64_t     begin{ 0 }; // microseconds since the tracer was created
+    int64_t     duration{ 0 };
+    int64_t     counters[std::size_t(ECounter::COUNT)]{};
+  };
+
+  Tracer();
+
+  void    push(const Event& event);
+  int64_t toMicroseconds(Clock::time_point time) const;
+
+  static uint32_t currentThreadId();
+
+  std::atomic_bool     m_enabled{ false };
+  std::atomic<int64_t> m_counters[std::size_t(ECounter::COUNT)]{};
+  Clock::time_point    m_origin;
+
+  mutable std::mutex m_mutex;
+  std::vector<Event> m_events;
+  std::size_t        m_next{ 0 }; // ring buffer write position
+  bool               m_wrapped{ false };
+};
+
+class TraceZone
+{
+  const char*               m_name;
+  Tracer::Clock::time_point m_begin;
+
+public:
+  TraceZone(const char* name)
+    : m_name(Tracer::sharedInstance().enabled() ? name : nullptr)
+  {
+    if (m_name)
+    {
+      m_begin = Tracer::Clock::now();
+    }
+  }
+
+  ~TraceZone()
+  {
+    if (m_name)
+    {
+      Tracer::sharedInstance().addZone(m_name, m_begin, Tracer::Clock::now());
+    }
+  }
+
+  TraceZone(const TraceZone&) = delete;
+  TraceZone& operator=(const TraceZone&) = delete;
+};
+
+} // namespace VGG
+
+#define VGG_TRACE_CONCAT_IMPL(a, b) a##b
+#define VGG_TRACE_CONCAT(a, b) VGG_TRACE_CONCAT_IMPL(a, b)
+#define VGG_TRACE_ZONE(name) ::VGG::TraceZone VGG_TRACE_CONCAT(vggTraceZone, __LINE__)(name)
+#define VGG_TRACE_COUNT(counter, delta)                                                            \
+  ::VGG::Tracer::sharedInstance().addCounter(::VGG::Tracer::ECounter::counter, delta)
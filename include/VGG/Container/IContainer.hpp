@@ -21,7 +21,10 @@
 #include "VggTypes.hpp"
 #include "VggPackage.hpp"
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <optional>
 
 namespace VGG
 {
@@ -71,6 +74,18 @@ public:
     return container()->dispatch();
   }
 
+  // When paint or dispatch has work to do next; nullopt if nothing is scheduled, the host can wait
+  // for the next event.
+  virtual std::optional<std::chrono::steady_clock::time_point> nextWakeUp()
+  {
+    return container()->nextWakeUp();
+  }
+
+  virtual uint64_t missedFrames()
+  {
+    return container()->missedFrames();
+  }
+
   virtual bool onEvent(UEvent evt)
   {
     return container()->onEvent(evt);
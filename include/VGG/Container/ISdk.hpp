@@ -18,6 +18,7 @@
 
 #include "Application/UIOptions.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -73,6 +74,14 @@ public:
   virtual int  updateElementProperties(
      const std::string&      updates, // json array string, std::vector<app::ElementUpdateProperty>
      const AnimationOptions& animation) = 0;
+  // commands: packed native endian 32-bit words, `op, node, index, values...` per command, no json
+  // parsing. `node` indexes nodeIds, float values are stored as their bit pattern. See
+  // app::ElementUpdateBatch for the ops.
+  virtual int updateElementPropertiesBatch(
+    const std::vector<std::string>& nodeIds,
+    const uint8_t*                  commands,
+    std::size_t                     size, // in bytes
+    const AnimationOptions&         animation) = 0;
   virtual std::string getElementProperty(
     const std::string& query                                 // json string, app::ElementGetProperty
     ) = 0;                                                   // return json string
@@ -134,6 +143,12 @@ public:
 
   virtual std::vector<uint8_t> makeImageSnapshot(const ImageOptions& options) = 0;
 
+  // Frame tracing, off unless VGG_TRACE is set to other than 0 at startup. The trace holds
+  // the recent zones and the counters per frame in the chrome trace event json format, it can be
+  // opened in chrome://tracing or Perfetto.
+  virtual void        setTracingEnabled(bool enabled) = 0;
+  virtual std::string chromeTrace() = 0;
+
   virtual void openUrl(const std::string& url, const std::string& target) = 0;
 };
 
@@ -32,6 +32,20 @@ struct ExporterInfo
   std::string graphicsInfo;
 };
 
+// Raw pixels of a frame in ImageOption::pixelFormat
+struct PixelView
+{
+  const char* data{ nullptr };
+  int         width{ 0 };
+  int         height{ 0 };
+  std::size_t rowBytes{ 0 };
+};
+
+// Returns where the width x height pixels of the frame go and sets their row stride, null fails.
+using PixelAllocator = std::function<void*(int width, int height, std::size_t& rowBytes)>;
+// The pixels are in a buffer of the iterator which is reused for the next frame.
+using PixelCallback = std::function<bool(const std::string& key, const PixelView& pixels)>;
+
 class ImageIteratorImpl;
 class Exporter;
 class ImageIterator
@@ -53,6 +67,28 @@ class ImageIterator
 public:
   bool           next(std::string& key, std::vector<char>& image);
   IteratorResult next();
+
+  // Streams the next frame into the callback band by band as RGB PNG or RAW. The output is not
+  // limited to the max surface size, except for LevelDetermine, and the memory is bounded by the
+  // bands in flight instead of the image size. The PNG deflate level follows encodeProfile like
+  // next(key, image), but the rows stay RGB, without the gray or palette output of SMALLEST. JPEG
+  // and WEBP are encoded from the surface like next(key, image) does and passed in one call. It
+  // does not take part in the pipelined export.
+  bool next(std::string& key, const StreamCallback& callback);
+
+  // Reads the raw pixels of the next frame from the render target without encoding them, into
+  // the caller's buffer or into a pooled one. Neither takes part in the pipelined export. A frame
+  // that fails, e.g. when allocate returns null, is skipped and false is returned; the key is set
+  // to the id of the failed frame and left empty at the end of the frames.
+  bool nextPixels(std::string& key, const PixelAllocator& allocate);
+  bool nextPixels(const PixelCallback& callback);
+
+  // Records the next frame once and plays it back at the size and in the format of each of
+  // ImageOption::variants, in parallel. images has an item per variant, empty if it failed. The
+  // variants are always drawn on cpu raster surfaces, on at most as many threads as there are
+  // cores, whatever the backend; these surfaces are not pooled and not counted in the memory limit
+  // of the exporter.
+  bool nextVariants(std::string& key, std::vector<std::vector<char>>& images);
   ImageIterator(ImageIterator&& other) noexcept;
   ImageIterator& operator=(ImageIterator&& other) noexcept = delete;
   ~ImageIterator();
@@ -65,7 +101,8 @@ class Exporter
   friend class ImageIteratorImpl;
 
 public:
-  Exporter();
+  // Falls back to EBackend::CPU when the exporter is built without vulkan.
+  Exporter(EBackend backend = EBackend::VULKAN);
   void info(ExporterInfo* info);
 
   ImageIterator render(
@@ -81,6 +118,14 @@ public:
   }
 
   void setOutputCallback(OutputCallback callback);
+
+  // Batch export: one exporter for a queue of documents keeps the graphics context, fonts, pooled
+  // surfaces and skia caches. Call resetDocumentState before the next document, it drops what
+  // belongs to the previous one.
+  void resetDocumentState();
+  // Budget of the caches and pooled surfaces in bytes. With 0 the caches are not limited and the
+  // pooled surfaces keep to 256 MiB, the size of one 8192 x 8192 surface.
+  void setMemoryLimit(std::size_t bytes);
   ~Exporter();
 };
 
@@ -33,6 +33,12 @@ public:
     BuilderResult&      result);
   bool           next(std::string& key, std::vector<char>& data);
   IteratorResult next();
+
+  // Streams the PDF of the next frame into the callback without buffering it.
+  bool next(std::string& key, const StreamCallback& callback);
+  // Streams the remaining frames into one PDF, a page per frame, fonts and images shared by the
+  // pages are embedded once.
+  bool nextDocument(const StreamCallback& callback);
   PDFIterator(const PDFIterator& other) = delete;
   PDFIterator& operator=(const PDFIterator& other) = delete;
   PDFIterator(PDFIterator&& other) noexcept;
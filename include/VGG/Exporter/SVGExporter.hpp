@@ -31,6 +31,9 @@ public:
     BuilderResult&      result);
   bool           next(std::string& key, std::vector<char>& data);
   IteratorResult next();
+
+  // Streams the SVG of the next frame into the callback without buffering it.
+  bool next(std::string& key, const StreamCallback& callback);
   SVGIterator(const SVGIterator&) = delete;
   SVGIterator& operator=(const SVGIterator&) = delete;
   SVGIterator(SVGIterator&& other) noexcept;
@@ -36,8 +36,27 @@ enum EImageType
   PNG,
   JPEG,
   WEBP,
+  RAW, // pixels in ImageOption::pixelFormat, row by row without padding
 };
 
+enum class EPixelFormat
+{
+  RGBA_8888,
+  BGRA_8888,
+};
+
+// Encoding speed against output size, see layer::EEncodeProfile
+enum class EEncodeProfile
+{
+  DEFAULT, // derived from imageQuality
+  FAST,
+  BALANCED,
+  SMALLEST,
+};
+
+// Receives the output piece by piece as it is produced, returns false to abort.
+using StreamCallback = std::function<bool(const char* data, std::size_t size)>;
+
 struct ImageOption
 {
   struct ScaleDetermine
@@ -70,14 +89,37 @@ struct ImageOption
     }
   };
   using SizePolicy = std::variant<ScaleDetermine, WidthDetermine, HeightDetermine, LevelDetermine>;
+
+  // One output of a multi-scale export, see ImageIterator::nextVariants
+  struct Variant
+  {
+    SizePolicy size = ScaleDetermine{ 1.f };
+    EImageType type{ EImageType::PNG };
+    int        imageQuality = 100;
+  };
   int        imageQuality = 100;
   SizePolicy size = ScaleDetermine{ 1.f };
   EImageType type{ EImageType::PNG };
+
+  // RAW only
+  EPixelFormat pixelFormat{ EPixelFormat::RGBA_8888 };
+  bool         premultiplied{ false };
+
+  // Pipelined export when > 0: frames are encoded on worker threads while the next ones render,
+  // at most this many frames are rendered ahead of the one returned by ImageIterator::next.
+  int maxFramesInFlight{ 0 };
+
+  // PNG, JPEG and WEBP; SMALLEST picks grayscale or palette PNG and lossless WEBP for flat content
+  EEncodeProfile encodeProfile{ EEncodeProfile::DEFAULT };
+
+  // Sizes and formats of the multi-scale export, e.g. @1x, @2x and @3x
+  std::vector<Variant> variants;
 };
 
 enum class EBackend
 {
   VULKAN,
+  CPU, // raster on the cpu threads, no graphics driver needed
 };
 
 class IteratorResult
@@ -96,8 +138,9 @@ public:
   struct TimeCost
   {
     // Connting in seconds
-    float render{ 0.f };
-    float encode{ 0.f }; // This time consuming is the sum of capturing and encoding stages
+    float       render{ 0.f };
+    float       encode{ 0.f }; // This time consuming is the sum of capturing and encoding stages
+    std::size_t bytes{ 0 };   // Size of the encoded output
     TimeCost(float render = 0.f, float encode = 0.f)
       : render(render)
       , encode(encode)
@@ -111,6 +154,7 @@ public:
     {
       render += other.render;
       encode += other.encode;
+      bytes += other.bytes;
       return *this;
     }
     TimeCost operator+(const TimeCost& other) const
@@ -178,6 +222,10 @@ struct ExportOption
 {
   bool enableExpand{ true };
   bool enableLayout{ true };
+
+  // Ids of the frames to export, all when empty. Only these frames and the masters they use are
+  // expanded and laid out.
+  std::vector<std::string> frameIds;
 };
 
 } // namespace VGG::exporter
@@ -19,6 +19,7 @@
 #include "PlatformAdapter/Helper/StringHelper.hpp"
 
 #include <emscripten/emscripten.h>
+#include <emscripten/val.h>
 
 using namespace VGG;
 
@@ -34,6 +35,7 @@ bool BrowserJSEngine::evalModule(const std::string& code)
 }
 
 bool BrowserJSEngine::evalModule(
+  const std::string&       handlerKey,
   const std::string&       code,
   VGG::EventPtr            event,
   std::shared_ptr<IVggEnv> env)
@@ -60,6 +62,33 @@ bool BrowserJSEngine::evalModule(
   return true;
 }
 
+bool BrowserJSEngine::postEvent(
+  const std::string&       event,
+  const std::string&       coalesceKey,
+  std::shared_ptr<IVggEnv> env)
+{
+  // Same thread as js, call the listener directly instead of evaluating a script per event
+  using emscripten::val;
+
+  auto global = val::global();
+  auto container = global[env->getContainerKey()];
+  if (container.isUndefined() || container.isNull())
+    return false;
+  auto wrapper = container[env->getEnv()];
+  if (wrapper.isUndefined() || wrapper.isNull())
+    return false;
+
+  global.set(env->currrentEnvName(), env->getEnv());
+  global.set(env->currrentVggName(), wrapper[env->getInstanceKey()]);
+
+  auto listener = wrapper[env->getListenerKey()];
+  if (listener.typeOf().as<std::string>() != "function")
+    return false;
+
+  listener(event);
+  return true;
+}
+
 void BrowserJSEngine::openUrl(const std::string& url, const std::string& target)
 {
   std::string js{ "window.location.assign('" };
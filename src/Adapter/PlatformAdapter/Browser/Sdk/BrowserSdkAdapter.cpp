@@ -67,10 +67,13 @@ EMSCRIPTEN_BINDINGS(vgg_sdk)
     // misc
     .function("texts", &VggSdk::texts)
     .function("makeImageSnapshot", &VggSdk::emMakeImageSnapshot)
+    .function("setTracingEnabled", &VggSdk::setTracingEnabled)
+    .function("chromeTrace", &VggSdk::chromeTrace)
     // doc
     .function("getElement", &VggSdk::getElement)
     .function("updateElement", &VggSdk::updateElement)
     .function("updateElementProperties", &VggSdk::updateElementProperties)
+    .function("updateElementPropertiesBatch", &VggSdk::jsUpdateElementPropertiesBatch)
     .function("getElementProperty", &VggSdk::getElementProperty)
     .function("addElementProperty", &VggSdk::addElementProperty)
     .function("deleteElementProperty", &VggSdk::deleteElementProperty)
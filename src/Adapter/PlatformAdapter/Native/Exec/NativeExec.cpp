@@ -68,6 +68,7 @@ bool NativeExec::evalModule(const std::string& code)
 }
 
 bool NativeExec::evalModule(
+  const std::string&       handlerKey,
   const std::string&       code,
   VGG::EventPtr            event,
   std::shared_ptr<IVggEnv> env)
@@ -76,20 +77,39 @@ bool NativeExec::evalModule(
   NodeAdapter::JsEventGenerator event_generator{ env, event_store.eventId() };
   event->accept(&event_generator);
 
-  std::string wrapped_script{ R"(
-    var { evalModule } = require('internal/process/execution');
-    var encoded_code = ')" };
-
-  std::string call_imported_function{ event_generator.getScript() };
-  call_imported_function.append("const dataUri = ");
-  call_imported_function.append(StringHelper::encode_script_to_data_uri(code));
-  call_imported_function.append("; const { default: handleEvent } = await import(dataUri); "
-                                "handleEvent(theVggEvent, theWrapper);");
-  wrapped_script.append(StringHelper::url_encode(call_imported_function));
+  // The code only travels with the first call for a key, node keeps the imported handler. The
+  // instance is shared by the documents, which may use the same file name for other code: then the
+  // code is sent again and replaces the handler. Keep the lock while scheduling so a concurrent
+  // clearModuleCache cannot slip in between.
+  const auto                        codeHash = std::hash<std::string>{}(code);
+  const std::lock_guard<std::mutex> lock(m_importedHandlersMutex);
+  auto [it, firstImport] = m_importedHandlers.try_emplace(handlerKey, codeHash);
+  const bool sendCode = firstImport || it->second != codeHash;
+  it->second = codeHash;
+  return m_impl->schedule_call_handler(
+    handlerKey,
+    sendCode ? &code : nullptr,
+    event_generator.getArgs());
+}
 
-  wrapped_script.append("'; evalModule(decodeURIComponent(encoded_code));");
+void NativeExec::clearModuleCache()
+{
+  const std::lock_guard<std::mutex> lock(m_importedHandlersMutex);
+  m_importedHandlers.clear();
+  m_impl->schedule_clear_handlers();
+}
 
-  return m_impl->schedule_eval(wrapped_script);
+bool NativeExec::postEvent(
+  const std::string&       event,
+  const std::string&       coalesceKey,
+  std::shared_ptr<IVggEnv> env)
+{
+  NativeJsEvent jsEvent;
+  jsEvent.m_args = { env->getContainerKey(), env->getEnv(),          env->getInstanceKey(),
+                     env->getListenerKey(),  env->currrentEnvName(), env->currrentVggName(),
+                     event };
+  jsEvent.m_coalesce_key = coalesceKey;
+  return m_impl->schedule_post_event(std::move(jsEvent));
 }
 
 bool NativeExec::inject(InjectFn fn)
@@ -16,18 +16,23 @@
 #include "PlatformAdapter/Native/Exec/NativeExecImpl.hpp"
 #include <stdint.h>
 #include <stdio.h>
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <string_view>
 #include "Utility/Log.hpp"
 #include "node.h"
 #include "uv.h"
+#include "v8-container.h"
 #include "v8-context.h"
+#include "v8-exception.h"
+#include "v8-function.h"
 #include "v8-initialization.h"
 #include "v8-isolate.h"
 #include "v8-local-handle.h"
 #include "v8-locker.h"
 #include "v8-maybe.h"
+#include "v8-persistent-handle.h"
 #include "v8-primitive.h"
 #include "v8-script.h"
 namespace node
@@ -51,6 +56,109 @@ using namespace node;
 using namespace v8;
 
 constexpr int THREAD_POOL_SIZE = 4;
+
+// Evaluates to a function(key, code, eventClass, eventId, containerKey, envKey, instanceKey).
+// The module `code` is imported once per key and its default export is kept, later events call it
+// directly and pass undefined code. Code passed for a key that has a handler replaces it, the key
+// was reused for other code. A module that fails to import keeps a no-op handler until the cache
+// is dropped or other code is passed. Calling the function without arguments drops the cached
+// handlers.
+constexpr const char* HANDLER_DISPATCHER_SCRIPT = R"(
+(function () {
+  const { evalModule } = require('internal/process/execution');
+  const handlers = new Map(); // key: handler function, or a promise while importing
+  const pending = new Map();  // import token: { resolve, reject }
+  let nextToken = 0;
+
+  globalThis[Symbol.for('vgg.settleEventHandler')] = (token, handler, error) => {
+    const callbacks = pending.get(token);
+    if (!callbacks) {
+      return;
+    }
+    pending.delete(token);
+    error === undefined ? callbacks.resolve(handler) : callbacks.reject(error);
+  };
+
+  return function (key, code, eventClass, eventId, containerKey, envKey, instanceKey) {
+    if (key === undefined) {
+      handlers.clear();
+      return;
+    }
+
+    const theWrapper = globalThis[containerKey][envKey];
+    const vgg = theWrapper[instanceKey];
+    const theVggEvent = new vgg[eventClass]();
+    theVggEvent.bindCppEvent(eventId);
+
+    if (code !== undefined) {
+      handlers.delete(key);
+    }
+    let handler = handlers.get(key);
+    if (typeof handler === 'function') {
+      handler(theVggEvent, theWrapper);
+      return;
+    }
+
+    if (!handler) {
+      if (code === undefined) {
+        console.error(`vgg: no event handler for ${key}`);
+        return;
+      }
+      const token = nextToken++;
+      const importing = new Promise((resolve, reject) => pending.set(token, { resolve, reject }));
+      importing.then(
+        (f) => handlers.get(key) === importing && handlers.set(key, f),
+        () => handlers.get(key) === importing && handlers.set(key, () => {}));
+      handlers.set(key, importing);
+      handler = importing;
+
+      const dataUri = 'data:text/javascript;charset=utf-8,' + encodeURIComponent(code);
+      evalModule(`
+        const settle = globalThis[Symbol.for('vgg.settleEventHandler')];
+        try {
+          const { default: handleEvent } = await import(${JSON.stringify(dataUri)});
+          settle(${token}, handleEvent);
+        } catch (e) {
+          settle(${token}, undefined, e);
+        }`);
+    }
+    handler.then((f) => f(theVggEvent, theWrapper)).catch((e) => console.error(e));
+  };
+})()
+)";
+
+// Evaluates to a function(records, recordSize), records is the flat array of NativeJsEvent args.
+// Sets the current env like VggExec::setEnv, then calls the listener with the event json.
+constexpr const char* EVENT_DISPATCHER_SCRIPT = R"(
+(function (records, recordSize) {
+  for (let i = 0; i + recordSize <= records.length; i += recordSize) {
+    const [containerKey, envKey, instanceKey, listenerKey, currentEnvName, currentVggName, event] =
+      records.slice(i, i + recordSize);
+    const theWrapper = globalThis[containerKey]?.[envKey];
+    globalThis[currentEnvName] = envKey;
+    globalThis[currentVggName] = theWrapper?.[instanceKey];
+
+    const listener = theWrapper?.[listenerKey];
+    if (listener) {
+      try {
+        listener(event);
+      } catch (e) {
+        console.error(e);
+      }
+    }
+  }
+})
+)";
+
+Local<Value> toV8String(Isolate* isolate, const std::string& value)
+{
+  return v8::String::NewFromUtf8(
+           isolate,
+           value.data(),
+           NewStringType::kNormal,
+           static_cast<int>(value.size()))
+    .ToLocalChecked();
+}
 } // namespace
 
 namespace VGG
@@ -59,16 +167,82 @@ namespace VGG
 /*
  * NativeExecImpl
  */
+NativeExecImpl::NativeExecImpl() = default;
+NativeExecImpl::~NativeExecImpl() = default;
+
 bool NativeExecImpl::schedule_eval(const std::string& code)
+{
+  NativeEvalTask* task = new NativeEvalTask();
+  task->m_code = code;
+  return schedule(task);
+}
+
+bool NativeExecImpl::schedule_call_handler(
+  const std::string&              handlerKey,
+  const std::string*              code,
+  const std::vector<std::string>& args)
+{
+  NativeEvalTask* task = new NativeEvalTask();
+  task->m_kind = NativeEvalTask::CALL_HANDLER;
+  if (code)
+  {
+    task->m_code = *code;
+  }
+  task->m_handler_key = handlerKey;
+  task->m_handler_args = args;
+  return schedule(task);
+}
+
+bool NativeExecImpl::schedule_clear_handlers()
+{
+  NativeEvalTask* task = new NativeEvalTask();
+  task->m_kind = NativeEvalTask::CLEAR_HANDLERS;
+  return schedule(task);
+}
+
+bool NativeExecImpl::schedule_post_event(NativeJsEvent event)
 {
   if (!check_state())
   {
-    FAIL("#NativeExecImpl::schedule_eval, error state");
+    FAIL("#NativeExecImpl::schedule_post_event, error state");
+    return false;
+  }
+  ASSERT(event.m_args.size() == NativeJsEvent::ARGS_SIZE);
+
+  bool isNewTask = false;
+  {
+    const std::lock_guard<std::mutex> lock(m_tasks_mutex);
+    // join the batch at the tail, tasks scheduled before it still run first; a full batch spills
+    // into a new one, which keeps the order
+    if (
+      m_tasks.empty() || m_tasks.back()->m_kind != NativeEvalTask::POST_EVENTS ||
+      !m_tasks.back()->m_events.add(std::move(event)))
+    {
+      auto task = new NativeEvalTask();
+      task->m_kind = NativeEvalTask::POST_EVENTS;
+      task->m_exec_impl_ptr = this;
+      task->m_events.add(std::move(event));
+      m_tasks.push(task);
+      isNewTask = true;
+    }
+  }
+  if (isNewTask)
+  {
+    uv_async_send(&m_async_task);
+  }
+
+  return true;
+}
+
+bool NativeExecImpl::schedule(NativeEvalTask* task)
+{
+  if (!check_state())
+  {
+    FAIL("#NativeExecImpl::schedule, error state");
+    delete task;
     return false;
   }
 
-  NativeEvalTask* task = new NativeEvalTask();
-  task->m_code = code;
   task->m_exec_impl_ptr = this;
 
   {
@@ -120,6 +294,109 @@ int NativeExecImpl::eval(std::string_view buffer)
   return 0;
 }
 
+int NativeExecImpl::call_handler(const NativeEvalTask& task)
+{
+  Locker         locker(m_isolate);
+  Isolate::Scope isolate_scope(m_isolate);
+  HandleScope    handle_scope(m_isolate);
+
+  auto           context = m_setup->context();
+  Context::Scope context_scope(context);
+
+  TryCatch try_catch(m_isolate);
+  if (!m_handler_dispatcher && !compile_function(HANDLER_DISPATCHER_SCRIPT, m_handler_dispatcher))
+  {
+    FAIL("#NativeExecImpl::call_handler, error, create handler dispatcher failed");
+    return -1;
+  }
+
+  std::vector<Local<Value>> argv;
+  if (task.m_kind == NativeEvalTask::CALL_HANDLER)
+  {
+    argv.push_back(toV8String(m_isolate, task.m_handler_key));
+    argv.push_back(
+      task.m_code.empty() ? Undefined(m_isolate).As<Value>() : toV8String(m_isolate, task.m_code));
+    for (auto& arg : task.m_handler_args)
+    {
+      argv.push_back(toV8String(m_isolate, arg));
+    }
+  }
+
+  auto dispatcher = m_handler_dispatcher->Get(m_isolate);
+  if (dispatcher->Call(context, Undefined(m_isolate), static_cast<int>(argv.size()), argv.data())
+        .IsEmpty())
+  {
+    WARN("#NativeExecImpl::call_handler, event handler threw");
+    return -1;
+  }
+
+  return 0;
+}
+
+int NativeExecImpl::dispatch_events(const NativeEvalTask& task)
+{
+  if (task.m_events.droppedEvents() > 0)
+  {
+    WARN(
+      "#NativeExecImpl::dispatch_events, js is busy, %zu events dropped",
+      task.m_events.droppedEvents());
+  }
+
+  Locker         locker(m_isolate);
+  Isolate::Scope isolate_scope(m_isolate);
+  HandleScope    handle_scope(m_isolate);
+
+  auto           context = m_setup->context();
+  Context::Scope context_scope(context);
+
+  TryCatch try_catch(m_isolate);
+  if (!m_event_dispatcher && !compile_function(EVENT_DISPATCHER_SCRIPT, m_event_dispatcher))
+  {
+    FAIL("#NativeExecImpl::dispatch_events, error, create event dispatcher failed");
+    return -1;
+  }
+
+  std::vector<Local<Value>> records;
+  records.reserve(task.m_events.events().size() * NativeJsEvent::ARGS_SIZE);
+  for (auto& event : task.m_events.events())
+  {
+    for (auto& arg : event.m_args)
+    {
+      records.push_back(toV8String(m_isolate, arg));
+    }
+  }
+
+  Local<Value> argv[] = { Array::New(m_isolate, records.data(), records.size()),
+                          Integer::New(m_isolate, NativeJsEvent::ARGS_SIZE) };
+  auto         dispatcher = m_event_dispatcher->Get(m_isolate);
+  if (dispatcher->Call(context, Undefined(m_isolate), 2, argv).IsEmpty())
+  {
+    WARN("#NativeExecImpl::dispatch_events, event dispatcher threw");
+    return -1;
+  }
+
+  return 0;
+}
+
+bool NativeExecImpl::compile_function(
+  const char*                                source,
+  std::unique_ptr<v8::Global<v8::Function>>& outFunction)
+{
+  auto          context = m_isolate->GetCurrentContext();
+  auto          code = v8::String::NewFromUtf8(m_isolate, source).ToLocalChecked();
+  Local<Script> script;
+  Local<Value>  function;
+  if (
+    !v8::Script::Compile(context, code).ToLocal(&script) ||
+    !script->Run(context).ToLocal(&function) || !function->IsFunction())
+  {
+    return false;
+  }
+
+  outFunction.reset(new Global<Function>(m_isolate, Local<Function>::Cast(function)));
+  return true;
+}
+
 int NativeExecImpl::run_node(
   const int                     argc,
   const char**                  argv,
@@ -252,6 +529,10 @@ int NativeExecImpl::run_node_instance(
       deinit_uv_async_task();
     }
 
+    // must be released before the isolate goes away
+    m_handler_dispatcher.reset();
+    m_event_dispatcher.reset();
+
     stop_node();
   }
 
@@ -318,18 +599,36 @@ void NativeExecImpl::deinit_uv_async_task()
 
 void NativeExecImpl::run_task()
 {
-  while (!m_tasks.empty())
+  while (true)
   {
-    auto task = m_tasks.front();
+    NativeEvalTask* task = nullptr;
     {
+      // a posted event may be joining the tail task, take it out under the lock
       const std::lock_guard<std::mutex> lock(m_tasks_mutex);
+      if (m_tasks.empty())
+        break;
+      task = m_tasks.front();
       m_tasks.pop();
     }
 
     DEBUG("#evalScript, before eval");
-    int ret = eval(task->m_code);
+    int ret = 0;
+    switch (task->m_kind)
+    {
+      case NativeEvalTask::EVAL:
+        ret = eval(task->m_code);
+        break;
+      case NativeEvalTask::POST_EVENTS:
+        ret = dispatch_events(*task);
+        break;
+      default:
+        ret = call_handler(*task);
+        break;
+    }
     DEBUG("#evalScript, after eval, ret = %d", ret);
     UNUSED(ret);
+
+    delete task;
   }
 }
 
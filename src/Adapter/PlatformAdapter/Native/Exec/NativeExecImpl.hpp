@@ -16,6 +16,7 @@
 #pragma once
 
 #include <string_view>
+#include <cstddef>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -26,6 +27,7 @@
 #include <unistd.h>
 #endif
 #include <uv.h>
+#include "NativeJsEventBatch.hpp"
 namespace VGG
 {
 class NativeExecImpl;
@@ -38,7 +40,10 @@ class MultiIsolatePlatform;
 } // namespace node
 namespace v8
 {
+class Function;
 class Isolate;
+template<class T>
+class Global;
 } // namespace v8
 
 namespace VGG
@@ -46,14 +51,38 @@ namespace VGG
 
 struct NativeEvalTask
 {
-  std::string     m_code;
-  NativeExecImpl* m_exec_impl_ptr = nullptr;
+  enum EKind
+  {
+    EVAL,           // compile and run m_code
+    CALL_HANDLER,   // run the event handler m_handler_key, m_code is the module source or empty
+    CLEAR_HANDLERS, // drop all cached event handlers
+    POST_EVENTS,    // deliver m_events to the js listeners in one call
+  };
+
+  EKind                      m_kind{ EVAL };
+  std::string                m_code;
+  std::string                m_handler_key;
+  std::vector<std::string>   m_handler_args;
+  NativeJsEventBatch         m_events;
+  NativeExecImpl*            m_exec_impl_ptr = nullptr;
 };
 
 class NativeExecImpl
 {
 public:
+  NativeExecImpl();
+  ~NativeExecImpl();
+
   bool schedule_eval(const std::string& code);
+  // Call the default export of the module `code` with the event described by `args`.
+  // Pass `code` on the first call for `handlerKey` only, later calls reuse the imported handler.
+  bool schedule_call_handler(
+    const std::string&              handlerKey,
+    const std::string*              code,
+    const std::vector<std::string>& args);
+  bool schedule_clear_handlers();
+  // Events posted before the node thread gets to them are delivered as one batch.
+  bool schedule_post_event(NativeJsEvent event);
   int  run_node(const int argc, const char** argv, std::shared_ptr<std::thread>& nodeThread);
   void notify_node_thread_to_stop();
   void stop_node();
@@ -61,7 +90,11 @@ public:
   node::Environment* getNodeEnv();
 
 private:
-  int eval(const std::string_view buffer);
+  bool schedule(NativeEvalTask* task);
+  int  eval(const std::string_view buffer);
+  int  call_handler(const NativeEvalTask& task);
+  int  dispatch_events(const NativeEvalTask& task);
+  bool compile_function(const char* source, std::unique_ptr<v8::Global<v8::Function>>& outFunction);
 
   int node_main(const std::vector<std::string>& args);
   int run_node_instance(
@@ -87,6 +120,10 @@ private:
   node::Environment*            m_env = nullptr;
   uv_loop_t*                    m_loop = nullptr;
 
+  // compiled once, owns the imported event handlers, node thread only
+  std::unique_ptr<v8::Global<v8::Function>> m_handler_dispatcher;
+  std::unique_ptr<v8::Global<v8::Function>> m_event_dispatcher;
+
   std::queue<NativeEvalTask*> m_tasks;
   std::mutex                  m_tasks_mutex;
 
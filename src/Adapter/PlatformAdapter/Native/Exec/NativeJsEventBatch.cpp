@@ -0,0 +1,66 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "NativeJsEventBatch.hpp"
+#include <algorithm>
+#include <iterator>
+
+namespace VGG
+{
+
+namespace
+{
+bool isSameListener(const NativeJsEvent& lhs, const NativeJsEvent& rhs)
+{
+  // all args but the event itself
+  return std::equal(lhs.m_args.begin(), lhs.m_args.end() - 1, rhs.m_args.begin());
+}
+} // namespace
+
+bool NativeJsEventBatch::add(NativeJsEvent&& event)
+{
+  if (!event.m_coalesce_key.empty())
+  {
+    // drop a pending duplicate, never move the event across one that can not be coalesced
+    for (auto it = m_events.rbegin(); it != m_events.rend() && !it->m_coalesce_key.empty(); ++it)
+    {
+      if (it->m_coalesce_key == event.m_coalesce_key && isSameListener(*it, event))
+      {
+        m_events.erase(std::next(it).base());
+        break;
+      }
+    }
+  }
+
+  if (m_events.size() >= m_maxSize)
+  {
+    // only an event that reports a state may be lost
+    auto it = std::find_if(
+      m_events.begin(),
+      m_events.end(),
+      [](const NativeJsEvent& e) { return !e.m_coalesce_key.empty(); });
+    if (it == m_events.end())
+    {
+      return false;
+    }
+    m_events.erase(it);
+    ++m_droppedEvents;
+  }
+
+  m_events.push_back(std::move(event));
+  return true;
+}
+
+} // namespace VGG
@@ -15,7 +15,8 @@
  */
 #pragma once
 
-#include <sstream>
+#include <string>
+#include <vector>
 #include "Application/EventVisitor.hpp"
 #include "Domain/IVggEnv.hpp"
 #include "UIEvent.hpp"
@@ -29,7 +30,7 @@ class JsEventGenerator : public EventVisitor
 {
   std::shared_ptr<IVggEnv> m_env;
   std::string              m_event_id;
-  std::string              m_script;
+  std::vector<std::string> m_args;
 
 public:
   JsEventGenerator(std::shared_ptr<IVggEnv> env, std::string eventId)
@@ -38,40 +39,37 @@ public:
   {
   }
 
-  std::string getScript()
+  // eventClass, eventId, containerKey, envKey, instanceKey; see NativeExecImpl's handler dispatcher
+  const std::vector<std::string>& getArgs()
   {
-    return m_script;
+    return m_args;
   }
 
   virtual void visit(VGG::KeyboardEvent* e) override
   {
-    makeScript("VggKeyboardEvent");
+    makeArgs("VggKeyboardEvent");
   }
 
   virtual void visit(VGG::MouseEvent* e) override
   {
-    makeScript("VggMouseEvent");
+    makeArgs("VggMouseEvent");
   }
 
   virtual void visit(VGG::TouchEvent* e) override
   {
-    makeScript("VggTouchEvent");
+    makeArgs("VggTouchEvent");
   }
 
 private:
-  void makeScript(std::string_view event)
+  void makeArgs(std::string_view event)
   {
     ASSERT(m_env);
 
-    std::ostringstream oss;
-    oss << "const containerKey = '" << m_env->getContainerKey() << "';"
-        << "const envKey = '" << m_env->getEnv() << "';"
-        << "const instanceKey = '" << m_env->getInstanceKey() << "';"
-        << "var theWrapper = globalThis[containerKey][envKey];"
-        << "const vgg = theWrapper[instanceKey];"
-        << "var theVggEvent = new vgg." << event << "();"
-        << "theVggEvent.bindCppEvent(" << m_event_id << ");";
-    m_script.append(oss.str());
+    m_args = { std::string(event),
+               m_event_id,
+               m_env->getContainerKey(),
+               m_env->getEnv(),
+               m_env->getInstanceKey() };
   }
 };
 
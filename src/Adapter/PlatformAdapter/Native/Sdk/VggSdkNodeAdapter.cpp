@@ -22,6 +22,7 @@
 #include <unordered_map>
 #include <utility>
 #include <vector>
+#include "Application/ElementUpdateBatch.hpp"
 #include "Application/RunLoop.hpp"
 #include "Application/UIOptions.hpp"
 #include "Application/VggSdk.hpp"
@@ -290,6 +291,7 @@ void VggSdkNodeAdapter::Init(napi_env env, napi_value exports)
     DECLARE_NODE_API_PROPERTY("getElement", GetElement),
     DECLARE_NODE_API_PROPERTY("updateElement", UpdateElement),
     DECLARE_NODE_API_PROPERTY("updateElementProperties", updateElementProperties),
+    DECLARE_NODE_API_PROPERTY("updateElementPropertiesBatch", updateElementPropertiesBatch),
     DECLARE_NODE_API_PROPERTY("getElementProperty", getElementProperty),
     DECLARE_NODE_API_PROPERTY("addElementProperty", addElementProperty),
     DECLARE_NODE_API_PROPERTY("deleteElementProperty", deleteElementProperty),
@@ -318,6 +320,8 @@ void VggSdkNodeAdapter::Init(napi_env env, napi_value exports)
     DECLARE_NODE_API_PROPERTY("getEventListeners", GetEventListeners),
 
     DECLARE_NODE_API_PROPERTY("openUrl", openUrl),
+    DECLARE_NODE_API_PROPERTY("setTracingEnabled", setTracingEnabled),
+    DECLARE_NODE_API_PROPERTY("chromeTrace", chromeTrace),
 
     DECLARE_NODE_API_PROPERTY("save", Save),
   };
@@ -1269,6 +1273,72 @@ napi_value VggSdkNodeAdapter::openUrl(napi_env env, napi_callback_info info)
   return nullptr;
 }
 
+napi_value VggSdkNodeAdapter::setTracingEnabled(napi_env env, napi_callback_info info)
+{
+  constexpr size_t ARG_COUNT = 1;
+  size_t           argc = ARG_COUNT;
+  napi_value       args[ARG_COUNT];
+  napi_value       _this;
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, args, &_this, NULL));
+
+  if (argc < ARG_COUNT)
+  {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  try
+  {
+    auto enabled = GetArgBoolValue(env, args[0]);
+
+    VggSdkNodeAdapter* sdkAdapter;
+    NODE_API_CALL(env, napi_unwrap(env, _this, reinterpret_cast<void**>(&sdkAdapter)));
+
+    SyncTaskInMainLoop<bool>{ [sdk = sdkAdapter->m_vggSdk, enabled]()
+                              {
+                                sdk->setTracingEnabled(enabled);
+                                return true;
+                              },
+                              [](bool) {} }();
+  }
+  catch (std::exception& e)
+  {
+    napi_throw_error(env, nullptr, e.what());
+  }
+
+  return nullptr;
+}
+
+napi_value VggSdkNodeAdapter::chromeTrace(napi_env env, napi_callback_info info)
+{
+  napi_value _this;
+  NODE_API_CALL(env, napi_get_cb_info(env, info, nullptr, nullptr, &_this, NULL));
+
+  try
+  {
+    VggSdkNodeAdapter* sdkAdapter;
+    NODE_API_CALL(env, napi_unwrap(env, _this, reinterpret_cast<void**>(&sdkAdapter)));
+
+    std::string result;
+    SyncTaskInMainLoop<bool>{ [&sdk = sdkAdapter->m_vggSdk, &result]()
+                              {
+                                result = sdk->chromeTrace();
+                                return true;
+                              },
+                              [](bool) {} }();
+
+    napi_value ret;
+    NODE_API_CALL(env, napi_create_string_utf8(env, result.data(), result.size(), &ret));
+    return ret;
+  }
+  catch (std::exception& e)
+  {
+    napi_throw_error(env, nullptr, e.what());
+  }
+
+  return nullptr;
+}
+
 napi_value VggSdkNodeAdapter::currentTheme(napi_env env, napi_callback_info info)
 {
   napi_value _this;
@@ -1494,6 +1564,81 @@ napi_value VggSdkNodeAdapter::updateElementProperties(napi_env env, napi_callbac
   return nullptr;
 }
 
+// updateElementPropertiesBatch(nodeIds: string[], commands: Uint32Array, options)
+napi_value VggSdkNodeAdapter::updateElementPropertiesBatch(napi_env env, napi_callback_info info)
+{
+  size_t     argc = 3;
+  napi_value args[3];
+  napi_value _this;
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, args, &_this, NULL));
+
+  if (argc != 3)
+  {
+    napi_throw_error(env, nullptr, "Wrong number of arguments");
+    return nullptr;
+  }
+
+  try
+  {
+    uint32_t nodeCount = 0;
+    NODE_API_CALL(env, napi_get_array_length(env, args[0], &nodeCount));
+    std::vector<std::string> nodeIds;
+    nodeIds.reserve(nodeCount);
+    for (uint32_t i = 0; i < nodeCount; ++i)
+    {
+      napi_value element;
+      NODE_API_CALL(env, napi_get_element(env, args[0], i, &element));
+      nodeIds.push_back(GetArgString(env, element));
+    }
+
+    napi_typedarray_type type;
+    size_t               length = 0;
+    void*                data = nullptr;
+    NODE_API_CALL(
+      env,
+      napi_get_typedarray_info(env, args[1], &type, &length, &data, nullptr, nullptr));
+    if (type != napi_uint32_array)
+    {
+      napi_throw_type_error(env, nullptr, "Wrong argument type. Uint32Array expected.");
+      return nullptr;
+    }
+    const auto bytes = static_cast<const uint8_t*>(data);
+
+    // copy out of the js heap, the batch is applied in the main loop
+    auto commands = std::make_shared<std::vector<uint8_t>>(
+      bytes,
+      bytes + length * sizeof(app::ElementUpdateBatch::Word));
+    auto ids = std::make_shared<std::vector<std::string>>(std::move(nodeIds));
+    const auto option = animationOptionsFromJsObject(env, args[2]);
+
+    VggSdkNodeAdapter* sdkAdapter;
+    NODE_API_CALL(env, napi_unwrap(env, _this, reinterpret_cast<void**>(&sdkAdapter)));
+
+    int successCount = 0;
+    SyncTaskInMainLoop<bool>{ [&successCount, sdk = sdkAdapter->m_vggSdk, ids, commands, option]()
+                              {
+                                successCount = sdk->updateElementPropertiesBatch(
+                                  *ids,
+                                  commands->data(),
+                                  commands->size(),
+                                  option);
+                                return true;
+                              },
+                              [](bool) {} }();
+
+    napi_value value;
+    auto       status = napi_create_int32(env, successCount, &value);
+    if (status == napi_ok)
+      return value;
+  }
+  catch (std::exception& e)
+  {
+    napi_throw_error(env, nullptr, e.what());
+  }
+
+  return nullptr;
+}
+
 napi_value VggSdkNodeAdapter::getElementProperty(napi_env env, napi_callback_info info)
 {
   size_t     argc = 1;
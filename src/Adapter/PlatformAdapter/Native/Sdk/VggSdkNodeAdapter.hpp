@@ -51,6 +51,7 @@ private:
   static napi_value GetElement(napi_env env, napi_callback_info info);
   static napi_value UpdateElement(napi_env env, napi_callback_info info);
   static napi_value updateElementProperties(napi_env env, napi_callback_info info);
+  static napi_value updateElementPropertiesBatch(napi_env env, napi_callback_info info);
   static napi_value getElementProperty(napi_env env, napi_callback_info info);
   static napi_value addElementProperty(napi_env env, napi_callback_info info);
   static napi_value deleteElementProperty(napi_env env, napi_callback_info info);
@@ -87,6 +88,8 @@ private:
 
   // -
   static napi_value openUrl(napi_env env, napi_callback_info info);
+  static napi_value setTracingEnabled(napi_env env, napi_callback_info info);
+  static napi_value chromeTrace(napi_env env, napi_callback_info info);
 
   // undo & redo
   static napi_value Undo(napi_env env, napi_callback_info info);
@@ -15,13 +15,13 @@
  */
 #include "Application/Animate.hpp"
 #include "Application/AttrBridge.hpp"
-#include "Utility/VggTimer.hpp"
 #include "Utility/Log.hpp"
 #include "Domain/Layout/LayoutNode.hpp"
 #include "Domain/Model/Element.hpp"
 #include "Layer/Core/PaintNode.hpp"
 #include "Layer/Core/SceneNode.hpp"
 #include "Application/UIView.hpp"
+#include <algorithm>
 #include <unordered_map>
 
 using namespace VGG;
@@ -129,6 +129,25 @@ void Interpolator::setFinished()
   m_finished = true;
 }
 
+void Interpolator::interpolate(
+  milliseconds  passedTime,
+  milliseconds  duration,
+  const double* from,
+  const double* to,
+  double*       out,
+  std::size_t   count)
+{
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    out[i] = (*this)(passedTime, from[i], to[i], duration);
+  }
+
+  if (passedTime >= duration)
+  {
+    setFinished();
+  }
+}
+
 double LinearInterpolator::operator()(
   milliseconds passedTime,
   double       from,
@@ -146,6 +165,31 @@ double LinearInterpolator::operator()(
   return (to - from) * passedTime.count() / duration.count() + from;
 }
 
+void LinearInterpolator::interpolate(
+  milliseconds  passedTime,
+  milliseconds  duration,
+  const double* from,
+  const double* to,
+  double*       out,
+  std::size_t   count)
+{
+  assert(duration.count());
+
+  if (passedTime >= duration || !duration.count())
+  {
+    setFinished();
+    std::copy(to, to + count, out);
+    return;
+  }
+
+  // progress once, then a plain loop the compiler can vectorize
+  const double progress = static_cast<double>(passedTime.count()) / duration.count();
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    out[i] = from[i] + (to[i] - from[i]) * progress;
+  }
+}
+
 Animate::Animate(
   milliseconds                  duration,
   milliseconds                  interval,
@@ -170,12 +214,10 @@ Animate::~Animate()
 void Animate::stop()
 {
   m_childAnimates.clear();
-
-  if (m_timer)
-  {
-    m_timer->invalidate();
-    m_timer = nullptr;
-  }
+  m_running = false;
+  m_trackFrom.clear();
+  m_trackTo.clear();
+  m_trackNow.clear();
 
   if (!m_callbackWhenStop.empty())
   {
@@ -199,7 +241,7 @@ bool Animate::isRunning()
     return m_parent->isRunning();
   }
 
-  return static_cast<bool>(m_timer);
+  return m_running;
 }
 
 bool Animate::isFinished()
@@ -284,25 +326,44 @@ void Animate::start()
     return;
   }
 
-  assert(!m_timer);
-  m_startTime = std::chrono::steady_clock::now();
-  m_lastTriggeredTime = m_startTime;
+  assert(!m_running);
+  m_running = true;
+  restartAt(std::chrono::steady_clock::now());
+}
+
+void Animate::restartAt(steady_clock::time_point time)
+{
+  m_startTime = time;
+  m_lastTriggeredTime = time;
+}
 
-  m_timer = std::make_shared<Timer>(
-    getInterval().count() / 1000.0,
-    [this]() { this->timerCallback(); },
-    true);
+void Animate::tick(steady_clock::time_point time)
+{
+  assert(isIndependent() && isRunning());
+
+  m_lastTriggeredTime = time;
+  interpolateTracks();
+  timerCallback();
+}
+
+void Animate::interpolateTracks()
+{
+  auto interpolator = getInterpolator();
+  assert(interpolator);
+
+  interpolator->interpolate(
+    getPassedTime(),
+    getDuration(),
+    m_trackFrom.data(),
+    m_trackTo.data(),
+    m_trackNow.data(),
+    m_trackNow.size());
 }
 
 void Animate::timerCallback()
 {
   assert(isRunning());
 
-  if (isIndependent())
-  {
-    m_lastTriggeredTime = steady_clock::now();
-  }
-
   for (auto& child : getChildAnimate())
   {
     child->timerCallback();
@@ -314,6 +375,35 @@ Animate* Animate::getParent()
   return m_parent;
 }
 
+Animate* Animate::getRoot()
+{
+  auto root = this;
+  while (root->m_parent)
+  {
+    root = root->m_parent;
+  }
+  return root;
+}
+
+std::size_t Animate::addTracks(const std::vector<double>& from, const std::vector<double>& to)
+{
+  assert(from.size() == to.size());
+
+  auto        root = getRoot();
+  std::size_t offset = root->m_trackNow.size();
+  root->m_trackFrom.insert(root->m_trackFrom.end(), from.begin(), from.end());
+  root->m_trackTo.insert(root->m_trackTo.end(), to.begin(), to.end());
+  root->m_trackNow.insert(root->m_trackNow.end(), from.begin(), from.end());
+  return offset;
+}
+
+const double* Animate::getTrackValues(std::size_t offset)
+{
+  auto root = getRoot();
+  assert(offset <= root->m_trackNow.size());
+  return root->m_trackNow.data() + offset;
+}
+
 void Animate::addChildAnimate(std::shared_ptr<Animate> child)
 {
   m_childAnimates.emplace_back(child);
@@ -329,11 +419,35 @@ void Animate::addCallBackWhenStop(std::function<void()>&& fun)
   m_callbackWhenStop.emplace_back(std::move(fun));
 }
 
+AnimateManage::AnimateManage()
+  : m_clock([this](steady_clock::time_point time) { tick(time); })
+{
+}
+
 void AnimateManage::addAnimate(std::shared_ptr<Animate> animate)
 {
   if (animate->isIndependent())
   {
+    // share the clock's time base, which is not the wall clock in manual mode
+    if (animate->isRunning())
+    {
+      animate->restartAt(m_clock.now());
+    }
     m_animates.emplace_back(animate);
+    m_clock.setActive(true);
+  }
+}
+
+void AnimateManage::tick(steady_clock::time_point time)
+{
+  // callbacks may start or stop animations
+  auto animates = m_animates;
+  for (auto& animate : animates)
+  {
+    if (animate->isRunning() && !animate->isFinished())
+    {
+      animate->tick(time);
+    }
   }
 }
 
@@ -365,6 +479,7 @@ bool AnimateManage::deleteFinishedAnimate()
   {
     //DEBUG("animate stopped");
     m_animates.erase(it, m_animates.end());
+    m_clock.setActive(!m_animates.empty());
     return true;
   }
 
@@ -398,17 +513,13 @@ void NumberAnimate::timerCallback()
 {
   Animate::timerCallback();
 
-  auto interpolator = getInterpolator();
-  assert(interpolator);
-
-  auto       passedTime = getPassedTime();
-  const auto size = m_nowValue.size();
-  assert(size && size == m_from.size() && size == m_to.size());
-
-  for (size_t i = 0; i < size; ++i)
+  // interpolated by the root animate for all its number animates at once
+  if (!m_trackOffset)
   {
-    m_nowValue[i] = (*interpolator)(passedTime, m_from.at(i), m_to.at(i), getDuration());
+    return;
   }
+  auto values = getTrackValues(*m_trackOffset);
+  std::copy(values, values + m_nowValue.size(), m_nowValue.begin());
 
   for (auto& item : getTriggeredCallback())
   {
@@ -419,9 +530,8 @@ void NumberAnimate::timerCallback()
 void NumberAnimate::setFromTo(const TParam& from, const TParam& to)
 {
   assert(!from.empty() && from.size() == to.size());
-  m_from = from;
-  m_to = to;
-  m_nowValue.resize(from.size());
+  m_trackOffset = addTracks(from, to);
+  m_nowValue = from;
 }
 
 ReplaceNodeAnimate::ReplaceNodeAnimate(
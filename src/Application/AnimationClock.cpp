@@ -0,0 +1,109 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Application/AnimationClock.hpp"
+#include "Utility/VggTimer.hpp"
+
+namespace VGG
+{
+
+AnimationClock::AnimationClock(TickCallback tickCallback)
+  : m_tickCallback(std::move(tickCallback))
+  , m_manualNow(std::chrono::steady_clock::now())
+{
+}
+
+AnimationClock::~AnimationClock()
+{
+  if (m_timer)
+  {
+    m_timer->invalidate();
+  }
+}
+
+void AnimationClock::setMode(EMode mode, std::chrono::milliseconds fixedInterval)
+{
+  if (mode == EMode::MANUAL && m_mode != EMode::MANUAL)
+  {
+    m_manualNow = std::chrono::steady_clock::now();
+  }
+
+  m_mode = mode;
+  m_fixedInterval = fixedInterval;
+  updateTimer();
+}
+
+AnimationClock::TimePoint AnimationClock::now() const
+{
+  return m_mode == EMode::MANUAL ? m_manualNow : std::chrono::steady_clock::now();
+}
+
+void AnimationClock::tick()
+{
+  if (m_mode == EMode::FRAME)
+  {
+    notify(std::chrono::steady_clock::now());
+  }
+}
+
+void AnimationClock::advance(std::chrono::milliseconds delta)
+{
+  if (m_mode == EMode::MANUAL)
+  {
+    m_manualNow += delta;
+    notify(m_manualNow);
+  }
+}
+
+void AnimationClock::setActive(bool active)
+{
+  if (m_active == active)
+  {
+    return;
+  }
+
+  m_active = active;
+  updateTimer();
+}
+
+void AnimationClock::notify(TimePoint time)
+{
+  if (m_tickCallback)
+  {
+    m_tickCallback(time);
+  }
+}
+
+void AnimationClock::updateTimer()
+{
+  const bool needsTimer = m_mode == EMode::FIXED_TICK && m_active;
+  if (m_timer)
+  {
+    m_timer->invalidate();
+    m_timer = nullptr;
+  }
+
+  if (needsTimer)
+  {
+    m_timer = std::make_shared<Timer>(
+      m_fixedInterval.count() / 1000.0,
+      [this]() { notify(std::chrono::steady_clock::now()); },
+      true);
+    m_timer->setup();
+  }
+}
+
+} // namespace VGG
@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <cstdlib>
 #include <deque>
 #include <exception>
 #include <fstream>
@@ -29,6 +30,7 @@
 #include "Domain/JsonDocument.hpp"
 #include "Domain/Layout/Layout.hpp"
 #include "Domain/Layout/LayoutNode.hpp"
+#include "Domain/Model/EventListenerTable.hpp"
 #include "Domain/Model/JsonKeys.hpp"
 #include "Domain/ModelEvent.hpp"
 #include "Domain/RawJsonDocument.hpp"
@@ -226,6 +228,11 @@ Controller::Controller(
 {
   assert(m_runLoop);
 
+  if (const char* snapshotDir = std::getenv("VGG_SNAPSHOT_DIR"))
+  {
+    m_snapshotDir = snapshotDir;
+  }
+
   if (m_editor)
   {
     m_editor->setListener(m_reporter);
@@ -355,6 +362,7 @@ void Controller::initModel(const char* designDocSchemaFilePath, const char* layo
   m_model.reset(new Daruma(
     createMakeJsonDocFn(designDocSchemaFilePath),
     createMakeJsonDocFn(layoutDocSchemaFilePath)));
+  m_model->setSnapshotDir(m_snapshotDir);
 
   if (auto env = m_env.lock())
   {
@@ -484,15 +492,16 @@ void Controller::handleEvent(UIEventPtr evt)
     return;
   }
 
-  auto        listenersMap = m_model->getEventListeners(evt->targetKey());
-  std::string type = evt->type();
-  if (auto it = listenersMap.find(type); it != listenersMap.end())
+  dropStaleEventHandlers();
+
+  auto table = m_model->eventListenerTable();
+  if (auto listeners = table->find(evt->targetKey(), evt->type()))
   {
-    for (auto& listener : it->second)
+    for (auto& listener : *listeners)
     {
       // todo, evt phase // kCapturingPhase = 1, // kAtTarget = 2, // kBubblingPhase = 3
       // todo, evt PropagationStopped
-      vggExec()->evalModule(listener, evt);
+      vggExec()->evalModule(listener.fileName, *listener.code, evt);
     }
   }
 
@@ -502,6 +511,16 @@ void Controller::handleEvent(UIEventPtr evt)
   }
 }
 
+void Controller::dropStaleEventHandlers()
+{
+  auto revision = m_model->eventListenersRevision();
+  if (revision != m_eventListenersRevision)
+  {
+    m_eventListenersRevision = revision;
+    vggExec()->clearModuleCache();
+  }
+}
+
 void Controller::observeEditViewEvent()
 {
   auto weakThis = weak_from_this();
@@ -514,13 +533,14 @@ void Controller::observeEditViewEvent()
         return;
       }
 
-      auto        listenersMap = sharedThis->m_model->getEventListeners(PSEUDO_PATH_EDIT_VIEW);
-      std::string type = evt->type();
-      if (auto it = listenersMap.find(type); it != listenersMap.end())
+      sharedThis->dropStaleEventHandlers();
+
+      auto table = sharedThis->m_model->eventListenerTable();
+      if (auto listeners = table->find(PSEUDO_PATH_EDIT_VIEW, evt->type()))
       {
-        for (auto& listener : it->second)
+        for (auto& listener : *listeners)
         {
-          sharedThis->vggExec()->evalModule(listener, evt);
+          sharedThis->vggExec()->evalModule(listener.fileName, *listener.code, evt);
         }
       }
     });
@@ -772,6 +792,11 @@ bool Controller::dismissState(const std::string& instanceDescendantId)
   return result.success;
 }
 
+void Controller::setSnapshotDir(const std::string& dir)
+{
+  m_snapshotDir = dir;
+}
+
 void Controller::setFitToViewportEnabled(bool enabled)
 {
   if (m_isFitToViewportEnabled == enabled)
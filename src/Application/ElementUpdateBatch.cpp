@@ -0,0 +1,279 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Application/ElementUpdateBatch.hpp"
+
+#include <cstring>
+
+namespace VGG::app
+{
+
+std::size_t ElementUpdateBatch::valueCount(EOp op)
+{
+  switch (op)
+  {
+    case EOp::FILL_BLEND_MODE:
+    case EOp::FILL_ENABLED:
+    case EOp::FILL_OPACITY:
+    case EOp::OPACITY:
+    case EOp::VISIBLE:
+      return 1;
+
+    case EOp::PATTERN_IMAGE_FILL_ROTATION:
+    case EOp::SIZE:
+      return 2;
+
+    case EOp::FILL_COLOR:
+      return 4;
+
+    case EOp::MATRIX:
+      return 6;
+
+    default:
+      return 0;
+  }
+}
+
+ElementUpdateBatch::ElementUpdateBatch(std::vector<std::string> nodeIds, std::vector<Word> words)
+  : m_nodeIds(std::move(nodeIds))
+  , m_words(std::move(words))
+{
+  for (Handle i = 0; i < m_nodeIds.size(); ++i)
+    m_handles.emplace(m_nodeIds[i], i);
+}
+
+ElementUpdateBatch::ElementUpdateBatch(
+  std::vector<std::string> nodeIds,
+  const uint8_t*           bytes,
+  std::size_t              size)
+  : ElementUpdateBatch(std::move(nodeIds), std::vector<Word>(size / sizeof(Word)))
+{
+  if (!m_words.empty())
+    std::memcpy(m_words.data(), bytes, m_words.size() * sizeof(Word));
+}
+
+ElementUpdateBatch::Handle ElementUpdateBatch::node(const std::string& id)
+{
+  if (auto it = m_handles.find(id); it != m_handles.end())
+    return it->second;
+
+  const auto handle = static_cast<Handle>(m_nodeIds.size());
+  m_nodeIds.push_back(id);
+  m_handles.emplace(id, handle);
+  return handle;
+}
+
+void ElementUpdateBatch::setFillBlendMode(Handle node, std::size_t index, int mode)
+{
+  append(EOp::FILL_BLEND_MODE, node, index, { static_cast<Word>(mode) });
+}
+
+void ElementUpdateBatch::setFillColor(
+  Handle      node,
+  std::size_t index,
+  float       a,
+  float       r,
+  float       g,
+  float       b)
+{
+  append(EOp::FILL_COLOR, node, index, { fromFloat(a), fromFloat(r), fromFloat(g), fromFloat(b) });
+}
+
+void ElementUpdateBatch::setFillEnabled(Handle node, std::size_t index, bool enabled)
+{
+  append(EOp::FILL_ENABLED, node, index, { enabled });
+}
+
+void ElementUpdateBatch::setFillOpacity(Handle node, std::size_t index, float opacity)
+{
+  append(EOp::FILL_OPACITY, node, index, { fromFloat(opacity) });
+}
+
+void ElementUpdateBatch::setPatternImageFillRotation(
+  Handle      node,
+  std::size_t index,
+  float       degree,
+  bool        effectOnFill)
+{
+  append(EOp::PATTERN_IMAGE_FILL_ROTATION, node, index, { fromFloat(degree), effectOnFill });
+}
+
+void ElementUpdateBatch::setMatrix(Handle node, float a, float b, float c, float d, float tx, float ty)
+{
+  append(
+    EOp::MATRIX,
+    node,
+    0,
+    { fromFloat(a), fromFloat(b), fromFloat(c), fromFloat(d), fromFloat(tx), fromFloat(ty) });
+}
+
+void ElementUpdateBatch::setOpacity(Handle node, float opacity)
+{
+  append(EOp::OPACITY, node, 0, { fromFloat(opacity) });
+}
+
+void ElementUpdateBatch::setVisible(Handle node, bool visible)
+{
+  append(EOp::VISIBLE, node, 0, { visible });
+}
+
+void ElementUpdateBatch::setSize(Handle node, float width, float height)
+{
+  append(EOp::SIZE, node, 0, { fromFloat(width), fromFloat(height) });
+}
+
+void ElementUpdateBatch::clear()
+{
+  m_nodeIds.clear();
+  m_words.clear();
+  m_handles.clear();
+}
+
+bool ElementUpdateBatch::read(
+  std::size_t&           offset,
+  Handle&                outNode,
+  ElementUpdateProperty& outProperty) const
+{
+  if (offset + HEADER_SIZE > m_words.size())
+    return false;
+
+  const auto op = static_cast<EOp>(m_words[offset]);
+  const auto count = valueCount(op);
+  if (count == 0 || offset + HEADER_SIZE + count > m_words.size())
+    return false;
+
+  outNode = m_words[offset + 1];
+  if (outNode >= m_nodeIds.size())
+    return false;
+
+  const std::size_t index = m_words[offset + 2];
+  const Word*       v = m_words.data() + offset + HEADER_SIZE;
+  switch (op)
+  {
+    case EOp::FILL_BLEND_MODE:
+    {
+      ElementUpdateFillBlendMode u;
+      u.index = index;
+      u.mode = static_cast<int>(v[0]);
+      outProperty = u;
+      break;
+    }
+    case EOp::FILL_COLOR:
+    {
+      ElementUpdateFillColor u;
+      u.index = index;
+      u.a = toFloat(v[0]);
+      u.r = toFloat(v[1]);
+      u.g = toFloat(v[2]);
+      u.b = toFloat(v[3]);
+      outProperty = u;
+      break;
+    }
+    case EOp::FILL_ENABLED:
+    {
+      ElementUpdateFillEnabled u;
+      u.index = index;
+      u.enabled = v[0] != 0;
+      outProperty = u;
+      break;
+    }
+    case EOp::FILL_OPACITY:
+    {
+      ElementUpdateFillOpacity u;
+      u.index = index;
+      u.opacity = toFloat(v[0]);
+      outProperty = u;
+      break;
+    }
+    case EOp::PATTERN_IMAGE_FILL_ROTATION:
+    {
+      ElementUpdatePatternImageFillRotation u;
+      u.index = index;
+      u.degree = toFloat(v[0]);
+      u.effectOnFill = v[1] != 0;
+      outProperty = u;
+      break;
+    }
+    case EOp::MATRIX:
+    {
+      ElementUpdateMatrix u;
+      u.a = toFloat(v[0]);
+      u.b = toFloat(v[1]);
+      u.c = toFloat(v[2]);
+      u.d = toFloat(v[3]);
+      u.tx = toFloat(v[4]);
+      u.ty = toFloat(v[5]);
+      outProperty = u;
+      break;
+    }
+    case EOp::OPACITY:
+    {
+      ElementUpdateOpacity u;
+      u.opacity = toFloat(v[0]);
+      outProperty = u;
+      break;
+    }
+    case EOp::VISIBLE:
+    {
+      ElementUpdateVisible u;
+      u.visible = v[0] != 0;
+      outProperty = u;
+      break;
+    }
+    case EOp::SIZE:
+    {
+      ElementUpdateSize u;
+      u.width = toFloat(v[0]);
+      u.height = toFloat(v[1]);
+      outProperty = u;
+      break;
+    }
+    default:
+      return false;
+  }
+
+  offset += HEADER_SIZE + count;
+  return true;
+}
+
+ElementUpdateBatch::Word ElementUpdateBatch::fromFloat(float value)
+{
+  static_assert(sizeof(Word) == sizeof(float));
+  Word word;
+  std::memcpy(&word, &value, sizeof(word));
+  return word;
+}
+
+float ElementUpdateBatch::toFloat(Word word)
+{
+  float value;
+  std::memcpy(&value, &word, sizeof(value));
+  return value;
+}
+
+void ElementUpdateBatch::append(
+  EOp                         op,
+  Handle                      node,
+  std::size_t                 index,
+  std::initializer_list<Word> values)
+{
+  m_words.push_back(static_cast<Word>(op));
+  m_words.push_back(node);
+  m_words.push_back(static_cast<Word>(index));
+  m_words.insert(m_words.end(), values.begin(), values.end());
+}
+
+} // namespace VGG::app
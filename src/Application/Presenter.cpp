@@ -23,6 +23,7 @@
 #include "Domain/Daruma.hpp"
 #include "Domain/Layout/LayoutNode.hpp"
 #include "Domain/Model/Element.hpp"
+#include "Domain/Model/EventListenerTable.hpp"
 #include "Layer/Model/StructModel.hpp"
 #include "Layer/SceneBuilder.hpp"
 #include "Mouse.hpp"
@@ -97,9 +98,8 @@ void Presenter::listenViewEvent()
       if (!sharedModel)
         return false;
 
-      auto        listenersMap = sharedModel->getEventListeners(targetKey);
-      std::string type = uiEventTypeToString(eventType);
-      if (listenersMap.find(type) != listenersMap.end()) // user listener
+      auto table = sharedModel->eventListenerTable();
+      if (table->has(targetKey, uiEventTypeToString(eventType))) // user listener
         return true;
 
       if (sharedThis->m_listenAllEvents)
@@ -122,16 +122,17 @@ void Presenter::listenViewEvent()
       if (!sharedModel)
         return false;
 
-      auto        listenersMap = sharedModel->getEventListeners(targetKey);
-      std::string type = uiEventTypeToString(eventType);
-      if (listenersMap.find(type) != listenersMap.end()) // hasUserListener
+      auto table = sharedModel->eventListenerTable();
+      auto listenersMap = table->find(targetKey);
+      auto hasListener = [listenersMap](EUIEventType type)
+      { return listenersMap && listenersMap->contains(uiEventTypeToString(type)); };
+      if (hasListener(eventType)) // hasUserListener
         return true;
 
       // process hover
-      auto shouldHandleHover =
-        listenersMap.find(uiEventTypeToString(EUIEventType::CLICK)) != listenersMap.end() ||
-        listenersMap.find(uiEventTypeToString(EUIEventType::MOUSEDOWN)) != listenersMap.end() ||
-        listenersMap.find(uiEventTypeToString(EUIEventType::MOUSEUP)) != listenersMap.end();
+      auto shouldHandleHover = hasListener(EUIEventType::CLICK) ||
+                               hasListener(EUIEventType::MOUSEDOWN) ||
+                               hasListener(EUIEventType::MOUSEUP);
       if (auto mouse = sharedThis->m_mouse)
       {
         DEBUG(
@@ -477,6 +478,13 @@ int Presenter::updateElement(
   return m_view->updateElement(items, option);
 }
 
+int Presenter::updateElement(
+  const app::ElementUpdateBatch& batch,
+  const app::UIAnimationOption&  option)
+{
+  return m_view->updateElement(batch, option);
+}
+
 std::optional<app::ElementProperty> Presenter::getElementProperty(
   const app::ElementGetProperty& query)
 {
@@ -23,6 +23,7 @@
 #include "Application/ElementAddProperty.hpp"
 #include "Application/ElementDeleteProperty.hpp"
 #include "Application/ElementGetProperty.hpp"
+#include "Application/ElementUpdateBatch.hpp"
 #include "Application/ElementUpdateProperty.hpp"
 #include "Application/UIAnimation.hpp"
 #include "Application/UIEvent.hpp"
@@ -304,6 +305,7 @@ public:
   int updateElement(
     const std::vector<app::ElementUpdateProperty>& items,
     const app::UIAnimationOption&                  option);
+  int updateElement(const app::ElementUpdateBatch& batch, const app::UIAnimationOption& option);
   std::optional<app::ElementProperty> getElementProperty(const app::ElementGetProperty& query);
   bool                                addElementProperty(const app::ElementAddProperty& command);
   bool deleteElementProperty(const app::ElementDeleteProperty& command);
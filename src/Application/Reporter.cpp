@@ -14,7 +14,6 @@
  * limitations under the License.
  */
 #include "Reporter.hpp"
-#include <sstream>
 #include <string>
 #include "Domain/Daruma.hpp"
 #include "Domain/DarumaContainer.hpp"
@@ -52,6 +51,7 @@ void Reporter::onSelectNode(std::weak_ptr<LayoutNode> node)
     return;
   }
 
+  // the fields are read from the typed model through the layout node, no json document is built
   auto model = env->darumaContainer().get();
   ASSERT(model);
   if (!model)
@@ -59,13 +59,6 @@ void Reporter::onSelectNode(std::weak_ptr<LayoutNode> node)
     return;
   }
 
-  const auto& designDoc = model->runtimeDesignDoc();
-  ASSERT(designDoc);
-  if (!designDoc)
-  {
-    return;
-  }
-
   nlohmann::json event;
   event[K_TYPE] = K_SELECT;
   event[K_ID] = target->id();
@@ -100,13 +93,6 @@ void Reporter::sendEventToJs(const nlohmann::json& event)
 {
   DEBUG("Reporter::sendEventToJs, event is: %s", event.dump().c_str());
 
-  auto env = m_env.lock();
-  if (!env)
-  {
-    FAIL("#Reporter::sendEventToJs, no env");
-    return;
-  }
-
   auto jsEngine = m_jsEngine.lock();
   if (!jsEngine)
   {
@@ -114,20 +100,22 @@ void Reporter::sendEventToJs(const nlohmann::json& event)
     return;
   }
 
-  std::ostringstream oss;
-  oss << "(function (event) {"
-      << "const containerKey = '" << env->getContainerKey() << "';"
-      << "const envKey = '" << env->getEnv() << "';"
-      << "const listenerKey = '" << env->getListenerKey() << "';"
-      << R"(
-          const listener = globalThis[containerKey]?.[envKey]?.[listenerKey]
-          if(listener) {
-            listener(event);
-          }
-        })
-      )"
-      << "('" << event.dump() << "');";
-  DEBUG("Reporter::sendEventToJs, script is: %s", oss.str().c_str());
-
-  jsEngine->evalModule(oss.str());
+  jsEngine->postEvent(event.dump(), coalesceKey(event));
+}
+
+std::string Reporter::coalesceKey(const nlohmann::json& event)
+{
+  // only the latest state matters for these, an undelivered one can be replaced
+  const auto& type = event.value(K_TYPE, std::string{});
+  if (type == K_SELECT)
+  {
+    return type;
+  }
+  if (
+    type == uiEventTypeToString(EUIEventType::MOUSEMOVE) ||
+    type == uiEventTypeToString(EUIEventType::TOUCHMOVE))
+  {
+    return type + ':' + event.value(K_ID, std::string{});
+  }
+  return {};
 }
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include "Editor.hpp"
 #include "UIEvent.hpp"
 #include <nlohmann/json.hpp>
@@ -47,6 +48,8 @@ public:
 
 private:
   void sendEventToJs(const nlohmann::json& event);
+
+  static std::string coalesceKey(const nlohmann::json& event);
 };
 
 } // namespace VGG
@@ -22,4 +22,22 @@ std::shared_ptr<RunLoop> RunLoop::sharedInstance()
 {
   static auto s_sharedInstance = std::shared_ptr<RunLoop>(new RunLoop);
   return s_sharedInstance;
-}
\ No newline at end of file
+}
+
+bool RunLoop::dispatch(std::chrono::microseconds budget)
+{
+  const auto start = Clock::now();
+  auto       ran = false;
+  while (hasDueWork())
+  {
+    if (ran && budget != std::chrono::microseconds::max() && Clock::now() - start >= budget)
+    {
+      break;
+    }
+
+    m_runLoop.dispatch();
+    ran = true;
+  }
+
+  return hasDueWork();
+}
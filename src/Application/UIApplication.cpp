@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <iterator>
 #include <optional>
+#include "AnimationClock.hpp"
 #include "AppRender.hpp"
 #include "Controller.hpp"
 #include "Domain/Layout/Rect.hpp"
@@ -25,7 +26,9 @@
 #include "Layer/Core/EventManager.hpp"
 #include "Layer/Graphics/GraphicsContext.hpp"
 #include "Application/VGGLayer.hpp"
+#include "RunLoop.hpp"
 #include "UIScrollView.hpp"
+#include "Utility/Trace.hpp"
 
 namespace VGG
 {
@@ -89,6 +92,7 @@ bool UIApplication::onEvent(UEvent evt, void* userData)
 
 bool UIApplication::paint(int fps, bool force)
 {
+  const auto paintStart = std::chrono::steady_clock::now();
   m_view->updateOncePerLoop();
 
   if (force || needsPaint())
@@ -97,12 +101,37 @@ bool UIApplication::paint(int fps, bool force)
     {
       fps = 0;
     }
+    else
+    {
+      m_frameInterval = fps > 0 ? std::chrono::nanoseconds(std::chrono::seconds(1)) / fps
+                                : std::chrono::nanoseconds(0);
+    }
 
     m_controller->updateDisplayContentIfNeeded();
+    const auto frameStart = std::chrono::steady_clock::now();
     if (m_layer->beginFrame(fps))
     {
-      m_layer->render();
-      m_layer->endFrame();
+      // one timestamp for all animations of this frame, only when a frame is drawn
+      m_view->animationClock().tick();
+      {
+        VGG_TRACE_ZONE("frame");
+        m_layer->render();
+        m_layer->endFrame();
+      }
+      Tracer::sharedInstance().markFrame();
+
+      if (m_frameInterval.count() > 0)
+      {
+        // a frame is due one interval after the previous one when that left work, otherwise when
+        // paint found work; every full interval between then and now is a missed frame
+        const auto due = m_frameWorkLeft ? m_lastFrameStart + m_frameInterval : paintStart;
+        const auto elapsed = std::chrono::steady_clock::now() - due;
+        if (elapsed >= m_frameInterval)
+        {
+          m_missedFrames += elapsed / m_frameInterval;
+        }
+      }
+      m_lastFrameStart = frameStart;
 
       if (m_firstRender)
       {
@@ -113,6 +142,7 @@ bool UIApplication::paint(int fps, bool force)
       m_view->frame();
 
       m_controller->postFrame();
+      m_frameWorkLeft = needsPaint();
       return true;
     }
   }
@@ -122,7 +152,46 @@ bool UIApplication::paint(int fps, bool force)
 
 bool UIApplication::needsPaint()
 {
-  return m_view->isDirty() || m_controller->hasDirtyEditor() || layer::EventManager::hasEvents();
+  const auto& clock = m_view->animationClock();
+  return m_view->isDirty() || m_controller->hasDirtyEditor() || layer::EventManager::hasEvents() ||
+         (clock.mode() == AnimationClock::EMode::FRAME && clock.isActive());
+}
+
+std::optional<std::chrono::steady_clock::time_point> UIApplication::nextWakeUp()
+{
+  std::optional<std::chrono::steady_clock::time_point> result =
+    RunLoop::sharedInstance()->nextDeadline();
+
+  if (needsPaint())
+  {
+    const auto nextFrame =
+      std::max(m_lastFrameStart + m_frameInterval, std::chrono::steady_clock::now());
+    if (!result || nextFrame < *result)
+    {
+      result = nextFrame;
+    }
+  }
+
+  return result;
+}
+
+std::chrono::microseconds UIApplication::frameBudget()
+{
+  using namespace std::chrono;
+
+  if (m_frameInterval.count() == 0)
+  {
+    return microseconds::max();
+  }
+
+  if (!needsPaint())
+  {
+    // nothing to draw, yield once per interval to keep the input responsive
+    return duration_cast<microseconds>(m_frameInterval);
+  }
+
+  const auto left = m_lastFrameStart + m_frameInterval - steady_clock::now();
+  return left.count() > 0 ? duration_cast<microseconds>(left) : microseconds(0);
 }
 
 bool UIApplication::handleKeyEvent(VKeyboardEvent evt)
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "UIView.hpp"
+#include <algorithm>
 #include <optional>
 #include "Domain/Layout/LayoutNode.hpp"
 #include "Domain/Model/Element.hpp"
@@ -26,6 +27,7 @@
 #include "UIOptions.hpp"
 #include "UIViewImpl.hpp"
 #include "Utility/Log.hpp"
+#include "Utility/Trace.hpp"
 #include "ViewModel.hpp"
 #include <core/SkColor.h>
 #include <glm/detail/qualifier.hpp>
@@ -74,8 +76,63 @@ Layout::Point pointToDocument(int x, int y, Layout::Point pointToPage, const Lay
 
 } // namespace
 
+// Hit paths of the pages at the point of the mouse event being dispatched. A mouse move is
+// dispatched as five event types and a mouse down looks for three click types, all of them are
+// answered from one walk of each page.
+struct UIView::HitPathCache
+{
+  struct Entry
+  {
+    Layout::Point       point;
+    LayoutNode::HitPath path;
+  };
+  std::unordered_map<const LayoutNode*, Entry> entries; // key: page
+
+  const LayoutNode::HitPath& get(LayoutNode& page, const Layout::Point& point)
+  {
+    auto [it, inserted] = entries.try_emplace(&page);
+    auto& entry = it->second;
+    if (inserted || !(entry.point == point) || !isValid(page, entry.path))
+    {
+      entry.point = point;
+      entry.path.clear();
+      page.hitTestPath(point, entry.path);
+    }
+    return entry.path;
+  }
+
+  void clear()
+  {
+    entries.clear();
+  }
+
+  // the hit node in target, same as target.hitTest(point, nullptr).first
+  static std::shared_ptr<LayoutNode> nodeInTarget(
+    const LayoutNode::HitPath& path,
+    LayoutNode&                target)
+  {
+    for (const auto& e : path)
+    {
+      if (target.isAncestorOf(e.node.get()))
+        return e.node;
+    }
+    return nullptr;
+  }
+
+private:
+  static bool isValid(LayoutNode& page, const LayoutNode::HitPath& path)
+  {
+    // a listener may have changed the tree while the previous event type was dispatched
+    return std::all_of(
+      path.begin(),
+      path.end(),
+      [&page](const LayoutNode::HitPathEntry& e) { return page.isAncestorOf(e.node.get()); });
+  }
+};
+
 UIView::UIView()
   : m_impl{ new internal::UIViewImpl(this) }
+  , m_hitPathCache{ new HitPathCache }
 {
 }
 
@@ -97,6 +154,13 @@ bool UIView::onEvent(UEvent evt, void* userData)
     return false;
   }
 
+  if (evt.type != VGG_MOUSEMOTION)
+  {
+    // keep the order of events
+    flushMouseMove();
+  }
+  m_hitPathCache->clear();
+
   // todo, capturing
   // todo, bubbling
   switch (evt.type)
@@ -116,8 +180,7 @@ bool UIView::onEvent(UEvent evt, void* userData)
 
     case VGG_MOUSEMOTION:
     {
-      m_lastMouseMove = evt;
-      onMouseMove(evt);
+      coalesceMouseMove(evt);
       return true;
     }
     break;
@@ -445,19 +508,20 @@ UIView::EventHandleResult UIView::dispatchMouseEventOnPage(
   const Layout::Point pointToPage = converPointFromWindowAndScale(x, y);
   const auto          p = pointToDocument(x, y, pointToPage, *page);
 
-  auto target = page->hitTest(
-    p,
+  const auto& path = m_hitPathCache->get(*page, p);
+  auto        target = LayoutNode::hitTest(
+    path,
     [&queryHasEventListener = m_hasEventListener, type](const std::string& targetKey)
     { return queryHasEventListener(targetKey, type); });
   std::shared_ptr<VGG::LayoutNode> hitNodeInTarget;
   if (target.first)
   {
-    hitNodeInTarget = target.first->hitTest(p, nullptr).first;
+    hitNodeInTarget = HitPathCache::nodeInTarget(path, *target.first);
   }
 
   if (updateCursor && (type == EUIEventType::MOUSEMOVE))
-    page->hitTest(
-      p,
+    LayoutNode::hitTest(
+      path,
       [&updateCursorEventListener = m_updateCursorEventListener, type](const std::string& targetKey)
       { return updateCursorEventListener(targetKey, type); });
 
@@ -470,8 +534,8 @@ UIView::EventHandleResult UIView::dispatchMouseEventOnPage(
                                EUIEventType::CONTEXTMENU };
       for (auto clickType : types)
       {
-        auto clickTarget = page->hitTest(
-          p,
+        auto clickTarget = LayoutNode::hitTest(
+          path,
           [&queryHasEventListener = m_hasEventListener, clickType](const std::string& targetKey)
           { return queryHasEventListener(targetKey, clickType); });
         if (clickTarget.first)
@@ -730,6 +794,7 @@ void UIView::show(
       static_pointer_cast<Domain::FrameElement>(f)->shouldDisplay())
       frames.emplace_back(layer::StructFrameObject(f.get()));
 
+  VGG_TRACE_ZONE("sceneBuild");
   auto result =
     layer::SceneBuilder::builder()
       .setFontNameVisitor(
@@ -1025,6 +1090,11 @@ void UIView::frame()
   setDirty(m_impl->deleteFinishedAnimation());
 }
 
+AnimationClock& UIView::animationClock()
+{
+  return m_impl->animationClock();
+}
+
 bool UIView::isDirty()
 {
   if (m_isDirty)
@@ -1134,8 +1204,47 @@ void UIView::onMouseMove(UEvent evt, bool forHover)
                            EUIEventType::MOUSEOUT,
                            EUIEventType::MOUSELEAVE };
   const auto&  m = evt.motion;
+  m_hitPathCache->clear();
   for (auto type : types)
     handleMouseEvent(0, m.windowX, m.windowY, m.xrel, m.yrel, type, forHover);
+  m_hitPathCache->clear();
+}
+
+void UIView::coalesceMouseMove(const UEvent& evt)
+{
+  if (m_pendingMouseMove)
+  {
+    // keep the latest position and the motion since the last dispatched one
+    const auto& pending = m_pendingMouseMove->motion;
+    auto        m = evt.motion;
+    m.xrel += pending.xrel;
+    m.yrel += pending.yrel;
+    m.canvasXRel += pending.canvasXRel;
+    m.canvasYRel += pending.canvasYRel;
+    m_pendingMouseMove->motion = m;
+  }
+  else
+  {
+    m_pendingMouseMove = evt;
+  }
+}
+
+void UIView::flushMouseMove()
+{
+  if (!m_pendingMouseMove)
+    return;
+
+  auto evt = *m_pendingMouseMove;
+  m_pendingMouseMove.reset();
+
+  m_lastMouseMove = evt;
+  onMouseMove(evt);
+}
+
+void UIView::updateOncePerLoop()
+{
+  m_skipUntilNextLoop = false;
+  flushMouseMove();
 }
 
 void UIView::updateState(const LayoutNode* instanceNode)
@@ -1178,6 +1287,16 @@ int UIView::updateElement(
   return successCount;
 }
 
+int UIView::updateElement(
+  const app::ElementUpdateBatch& batch,
+  const app::UIAnimationOption&  option)
+{
+  int successCount = m_impl->updateElement(batch, option);
+  if (successCount > 0)
+    setDirty(true);
+  return successCount;
+}
+
 std::optional<app::ElementProperty> UIView::getElementProperty(const app::ElementGetProperty& query)
 {
   return m_impl->getElementProperty(query);
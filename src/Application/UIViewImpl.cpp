@@ -27,6 +27,7 @@
 #include "Application/AppLayoutContext.hpp"
 #include "Application/Pager.hpp"
 #include "Application/ElementGetProperty.hpp"
+#include "Application/ElementUpdateBatch.hpp"
 #include "Application/ElementUpdateProperty.hpp"
 #include "Application/ViewModel.hpp"
 #include "AttrBridge.hpp"
@@ -40,6 +41,7 @@
 #include "Layer/Core/PaintNode.hpp"
 #include "Layer/Core/ResourceManager.hpp"
 #include "Layer/Core/ResourceProvider.hpp"
+#include "Layer/Core/VNode.hpp"
 #include "UIAnimation.hpp"
 #include "UIView.hpp"
 #include "Utility/Log.hpp"
@@ -508,6 +510,11 @@ bool UIViewImpl::isAnimating()
   return m_animationManager.hasRunningAnimation();
 }
 
+AnimationClock& UIViewImpl::animationClock()
+{
+  return m_animationManager.clock();
+}
+
 bool UIViewImpl::setInstanceState(
   const LayoutNode*             oldNode,
   const LayoutNode*             newNode,
@@ -638,7 +645,7 @@ std::optional<UIViewImpl::UpdateBuilder> UIViewImpl::makeUpdateBuilder(
   if (!root)
     return std::nullopt;
 
-  auto layoutNode = root->findDescendantNodeById(id);
+  auto layoutNode = m_viewModel->findNodeById(id);
   if (!layoutNode)
     return std::nullopt;
 
@@ -646,6 +653,20 @@ std::optional<UIViewImpl::UpdateBuilder> UIViewImpl::makeUpdateBuilder(
   if (!paintNode)
     return std::nullopt;
 
+  auto updater = std::make_shared<AttrBridge>(
+    std::static_pointer_cast<UIView>(m_api->shared_from_this()),
+    m_animationManager);
+
+  return UpdateBuilder{ updater,
+                        layoutNode->shared_from_this(),
+                        paintNode,
+                        makeUpdateAnimation(option, parentAnimation) };
+}
+
+std::shared_ptr<NumberAnimate> UIViewImpl::makeUpdateAnimation(
+  const app::UIAnimationOption* option,
+  Animate*                      parentAnimation)
+{
   std::shared_ptr<NumberAnimate> animation;
   if (parentAnimation)
   {
@@ -661,12 +682,7 @@ std::optional<UIViewImpl::UpdateBuilder> UIViewImpl::makeUpdateBuilder(
       std::chrono::milliseconds(K_ANIMATION_INTERVAL),
       timing);
   }
-
-  auto updater = std::make_shared<AttrBridge>(
-    std::static_pointer_cast<UIView>(m_api->shared_from_this()),
-    m_animationManager);
-
-  return UpdateBuilder{ updater, layoutNode->shared_from_this(), paintNode, animation };
+  return animation;
 }
 
 int UIViewImpl::updateElement(
@@ -689,6 +705,60 @@ int UIViewImpl::updateElement(
   return successCount;
 }
 
+int UIViewImpl::updateElement(
+  const app::ElementUpdateBatch& batch,
+  const app::UIAnimationOption&  option)
+{
+  const auto& root = m_viewModel->layoutTree();
+  if (!root || batch.empty())
+    return 0;
+
+  struct ResolvedNode
+  {
+    bool                        resolved = false;
+    std::shared_ptr<LayoutNode> layoutNode;
+    layer::PaintNode*           paintNode = nullptr;
+  };
+  std::vector<ResolvedNode> nodes(batch.nodeIds().size()); // indexed by batch handle
+
+  auto updater = std::make_shared<AttrBridge>(
+    std::static_pointer_cast<UIView>(m_api->shared_from_this()),
+    m_animationManager);
+
+  // the nodes are invalidated once, when it goes out of scope after the last command
+  layer::VNode::InvalidationBatch invalidation;
+  int                             successCount = 0;
+  std::shared_ptr<NumberAnimate>  animation;
+  std::size_t                     offset = 0;
+  app::ElementUpdateBatch::Handle handle = 0;
+  app::ElementUpdateProperty      item;
+  while (batch.read(offset, handle, item))
+  {
+    auto& node = nodes[handle];
+    if (!node.resolved)
+    {
+      node.resolved = true;
+      if (auto layoutNode = m_viewModel->findNodeById(batch.nodeIds()[handle]))
+      {
+        node.paintNode = m_sceneNode->nodeByID(layoutNode->elementNode()->idNumber());
+        node.layoutNode = layoutNode->shared_from_this();
+      }
+    }
+    if (!node.paintNode)
+      continue;
+
+    UpdateBuilder b{ updater,
+                     node.layoutNode,
+                     node.paintNode,
+                     makeUpdateAnimation(&option, animation.get()) };
+    if (!animation)
+      animation = b.animation; // first animation is parent
+    successCount += std::visit(UpdateVisitor{ b }, item);
+  }
+
+  return successCount;
+}
+
 std::optional<app::ElementProperty> UIViewImpl::getElementProperty(
   const app::ElementGetProperty& query)
 {
@@ -704,7 +774,7 @@ layer::PaintNode* UIViewImpl::getPaintNode(const std::string& id)
   if (!root)
     return nullptr;
 
-  auto layoutNode = root->findDescendantNodeById(id);
+  auto layoutNode = m_viewModel->findNodeById(id);
   if (!layoutNode)
     return nullptr;
 
@@ -731,7 +801,7 @@ std::optional<UIViewImpl::CommandContext> UIViewImpl::makeCommandContext(const s
   if (!root)
     return std::nullopt;
 
-  auto layoutNode = root->findDescendantNodeById(id);
+  auto layoutNode = m_viewModel->findNodeById(id);
   if (!layoutNode)
     return std::nullopt;
 
@@ -24,6 +24,7 @@
 #include "Application/ElementAddProperty.hpp"
 #include "Application/ElementDeleteProperty.hpp"
 #include "Application/ElementGetProperty.hpp"
+#include "Application/ElementUpdateBatch.hpp"
 #include "Application/ElementUpdateProperty.hpp"
 #include "Application/UIAnimation.hpp"
 #include "Application/ZoomerNodeController.hpp"
@@ -113,13 +114,15 @@ public:
   std::unique_ptr<LayoutContext> layoutContext();
 
 public:
-  bool deleteFinishedAnimation();
-  bool isAnimating();
+  bool            deleteFinishedAnimation();
+  bool            isAnimating();
+  AnimationClock& animationClock();
 
 public:
   int updateElement(
     const std::vector<app::ElementUpdateProperty>& items,
     const app::UIAnimationOption&                  option);
+  int updateElement(const app::ElementUpdateBatch& batch, const app::UIAnimationOption& option);
   std::optional<app::ElementProperty> getElementProperty(const app::ElementGetProperty& query);
   bool                                addElementProperty(const app::ElementAddProperty& command);
   bool deleteElementProperty(const app::ElementDeleteProperty& command);
@@ -128,6 +131,9 @@ public:
     const std::string&            id,
     const app::UIAnimationOption* anamation,
     Animate*                      parentAnimation);
+  std::shared_ptr<NumberAnimate> makeUpdateAnimation(
+    const app::UIAnimationOption* option,
+    Animate*                      parentAnimation);
   std::optional<CommandContext> makeCommandContext(const std::string& id);
   layer::PaintNode*             getPaintNode(const std::string& id);
 
@@ -37,6 +37,7 @@
 #include "Layer/SimpleRasterExecutor.hpp"
 
 #include "Layer/Renderer.hpp"
+#include "Layer/Exporter/ImageExporter.hpp"
 #include "Layer/Stream.hpp"
 #include "Layer/Graphics/VSkiaContext.hpp"
 
@@ -44,6 +45,7 @@
 #include "Layer/Graphics/GraphicsContext.hpp"
 #include "Layer/Graphics/ContextSkBase.hpp"
 #include "Utility/CappingProfiler.hpp"
+#include "Utility/Trace.hpp"
 
 #include <optional>
 
@@ -218,11 +220,18 @@ public:
     {
       Renderer r;
       r = r.createNew(canvas);
-      EventManager::pollEvents();
       Revalidation        rev;
       std::vector<Bounds> damageBounds;
-      rasterNode->revalidate(&rev, glm::mat3{ 1 });
-      rasterNode->raster(mergeBounds(rev.boundsArray()));
+      {
+        VGG_TRACE_ZONE("revalidate");
+        EventManager::pollEvents();
+        rasterNode->revalidate(&rev, glm::mat3{ 1 });
+      }
+      {
+        VGG_TRACE_ZONE("raster");
+        rasterNode->raster(mergeBounds(rev.boundsArray()));
+      }
+      VGG_TRACE_ZONE("draw");
       rasterNode->render(&r);
     }
     if (drawTextInfo)
@@ -465,6 +474,7 @@ void VLayer::endFrame()
 {
   VGG_IMPL(VLayer)
   ASSERT(context());
+  VGG_TRACE_ZONE("present");
   _->skiaContext->flushAndSubmit();
   context()->swap();
   _->skiaContext->markSwap();
@@ -517,20 +527,16 @@ std::optional<std::vector<char>> VLayer::makeImageSnapshot(const ImageOptions& o
   VGG_IMPL(VLayer);
   auto surface = _->skiaContext->surface();
   _->renderInternal(surface->getCanvas(), false);
+  if (opts.encode == EImageEncode::IE_RAW)
+  {
+    return exporter::makeImage(opts, surface); // read back without a snapshot
+  }
   auto ctx = _->skiaContext->context();
   if (
     auto image = surface->makeImageSnapshot(
       SkIRect::MakeXYWH(opts.position[0], opts.position[1], opts.extend[0], opts.extend[1])))
   {
-    if (opts.encode != EImageEncode::IE_RAW)
-    {
-      return encodeImage(ctx, opts.encode, image.get(), opts.quality);
-    }
-    else
-    {
-      DEBUG("raw data is not supported now");
-      return std::nullopt;
-    }
+    return encodeImage(ctx, opts.encode, image.get(), opts.quality);
   }
   return std::nullopt;
 }
@@ -18,6 +18,7 @@
 #include "Application/ElementAddPropertySerializer.hpp"
 #include "Application/ElementDeletePropertySerializer.hpp"
 #include "Application/ElementGetPropertySerializer.hpp"
+#include "Application/ElementUpdateBatch.hpp"
 #include "Application/ElementUpdatePropertySerializer.hpp"
 #include "Application/Presenter.hpp"
 #include "Application/UIApplication.hpp"
@@ -34,6 +35,7 @@
 #include "UIOptions.hpp"
 #include "UseCase/SaveModel.hpp"
 #include "Utility/Log.hpp"
+#include "Utility/Trace.hpp"
 #include <nlohmann/json.hpp>
 
 #ifdef EMSCRIPTEN
@@ -430,6 +432,16 @@ emscripten::val VggSdk::emMakeImageSnapshot(const ImageOptions& options)
 }
 #endif
 
+void VggSdk::setTracingEnabled(bool enabled)
+{
+  Tracer::sharedInstance().setEnabled(enabled);
+}
+
+std::string VggSdk::chromeTrace()
+{
+  return Tracer::sharedInstance().dumpChromeTrace();
+}
+
 bool VggSdk::setState(
   const std::string&  instanceDescendantId,
   const std::string&  listenerId,
@@ -571,6 +583,40 @@ int VggSdk::updateElementProperties(const std::string& updates, const AnimationO
   return 0;
 }
 
+int VggSdk::updateElementPropertiesBatch(
+  const std::vector<std::string>& nodeIds,
+  const uint8_t*                  commands,
+  std::size_t                     size,
+  const AnimationOptions&         animation)
+{
+  if (const auto& p = presenter())
+  {
+    const app::ElementUpdateBatch batch{ nodeIds, commands, size };
+    return p->updateElement(batch, toUIAnimationOption(animation));
+  }
+
+  return 0;
+}
+
+#ifdef EMSCRIPTEN
+int VggSdk::jsUpdateElementPropertiesBatch(
+  const emscripten::val&  nodeIds,
+  const emscripten::val&  words,
+  const AnimationOptions& animation)
+{
+  if (const auto& p = presenter())
+  {
+    const app::ElementUpdateBatch batch{
+      emscripten::vecFromJSArray<std::string>(nodeIds),
+      emscripten::convertJSArrayToNumberVector<app::ElementUpdateBatch::Word>(words)
+    };
+    return p->updateElement(batch, toUIAnimationOption(animation));
+  }
+
+  return 0;
+}
+#endif
+
 std::string VggSdk::getElementProperty(const std::string& query)
 {
   if (const auto& p = presenter())
@@ -32,6 +32,18 @@ std::shared_ptr<LayoutNode> ViewModel::layoutTree() const
   return {};
 }
 
+LayoutNode* ViewModel::findNodeById(const std::string& id) const
+{
+  auto sharedLayout = layout.lock();
+  ASSERT(sharedLayout);
+  if (sharedLayout)
+  {
+    return sharedLayout->findNodeById(id);
+  }
+
+  return nullptr;
+}
+
 std::shared_ptr<Domain::DesignDocument> ViewModel::designDoc() const
 {
   auto sharedLayout = layout.lock();
@@ -38,6 +38,7 @@ struct ViewModel
   std::weak_ptr<Layout::Layout> layout;
 
   std::shared_ptr<LayoutNode>             layoutTree() const;
+  LayoutNode*                             findNodeById(const std::string& id) const; // indexed
   std::shared_ptr<Domain::DesignDocument> designDoc() const;
 
   VGG::Model::Loader::ResourcesType resources() const
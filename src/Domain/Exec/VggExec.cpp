@@ -31,10 +31,24 @@ bool VggExec::evalModule(const std::string& program)
   return m_jsEngine->evalModule(program);
 }
 
-bool VggExec::evalModule(const std::string& code, VGG::EventPtr event)
+bool VggExec::evalModule(
+  const std::string& handlerKey,
+  const std::string& code,
+  VGG::EventPtr      event)
 {
   setEnv();
-  return m_jsEngine->evalModule(code, event, m_env);
+  return m_jsEngine->evalModule(handlerKey, code, event, m_env);
+}
+
+void VggExec::clearModuleCache()
+{
+  m_jsEngine->clearModuleCache();
+}
+
+bool VggExec::postEvent(const std::string& event, const std::string& coalesceKey)
+{
+  // the engine sets the current env before calling the listener, no setEnv script per event
+  return m_jsEngine->postEvent(event, coalesceKey, m_env);
 }
 
 void VggExec::setEnv()
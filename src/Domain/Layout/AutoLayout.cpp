@@ -1382,7 +1382,7 @@ std::shared_ptr<LayoutNode> AutoLayout::setNeedsLayout()
   {
     if (auto container = sharedView->autoLayoutContainer())
     {
-      return container->autoLayout()->setNeedsLayout();
+      return container->autoLayout()->setChildNeedsLayout();
     }
   }
 
@@ -1395,6 +1395,23 @@ std::shared_ptr<LayoutNode> AutoLayout::setNeedsLayout()
   return nullptr;
 }
 
+std::shared_ptr<LayoutNode> AutoLayout::setChildNeedsLayout()
+{
+  // The size of this container does not change with its children, the outer container need not
+  // layout again. Only when the layout of this container can be calculated alone.
+  auto sharedView = view.lock();
+  if (sharedView && isContainer() && isSizeIndependentOfChildren() && isLaidOutAlone())
+  {
+    DEBUG(
+      "AutoLayout::setChildNeedsLayout, stop at fixed size container, %s",
+      sharedView->id().c_str());
+    sharedView->setNeedsLayout();
+    return sharedView;
+  }
+
+  return setNeedsLayout();
+}
+
 flexbox_node* AutoLayout::getOrCreateFlexContainer()
 {
   if (!isFlexContainer())
@@ -1475,6 +1492,30 @@ bool AutoLayout::isGridContainer()
   return gridLayout() != nullptr;
 }
 
+bool AutoLayout::isSizeIndependentOfChildren()
+{
+  auto sharedRule = rule.lock();
+  if (!sharedRule)
+  {
+    return false;
+  }
+
+  auto isIndependent = [](const Length& length)
+  { return length.types == Length::ETypes::PX || length.types == Length::ETypes::PERCENT; };
+  return isIndependent(sharedRule->width.value) && isIndependent(sharedRule->height.value);
+}
+
+bool AutoLayout::isLaidOutAlone()
+{
+  // a flex node included in the flex tree of its container is calculated with that tree
+  if (m_flexNodePtr)
+  {
+    return m_flexNode != nullptr;
+  }
+
+  return isGridContainer();
+}
+
 GridLayout* AutoLayout::gridLayout()
 {
   auto sharedRule = rule.lock();
@@ -70,7 +70,8 @@ public:
   void setFrame(Rect frame);
   void updateSizeRule(Size newSize);
 
-  std::shared_ptr<LayoutNode> setNeedsLayout(); // return node that needs layout
+  std::shared_ptr<LayoutNode> setNeedsLayout();      // return node that needs layout
+  std::shared_ptr<LayoutNode> setChildNeedsLayout(); // for container, return node that needs layout
 
   void removeSubtree();
 
@@ -165,6 +166,9 @@ private:
   bool isFlexContainer();
   bool isGridContainer();
 
+  bool isSizeIndependentOfChildren();
+  bool isLaidOutAlone();
+
   bool shouldChangeContainerHugWidth();
   bool shouldChangeContainerHugHeight();
 
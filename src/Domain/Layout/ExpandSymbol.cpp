@@ -18,7 +18,6 @@
 #include <cstring>
 #include <fstream>
 #include <iterator>
-#include <numeric>
 #include <optional>
 #include <variant>
 #include "DesignModel.hpp"
@@ -30,6 +29,7 @@
 #include "Rect.hpp"
 #include "Rule.hpp"
 #include "Utility/Log.hpp"
+#include "Utility/Trace.hpp"
 #include "Utility/VggString.hpp"
 #include <nlohmann/json.hpp>
 
@@ -65,6 +65,15 @@ ExpandSymbol::ExpandSymbol(const nlohmann::json& designJson, const nlohmann::jso
 {
 }
 
+ExpandSymbol::ExpandSymbol(
+  std::shared_ptr<Model::DesignModel> designModel,
+  const nlohmann::json&               layoutJson)
+  : m_designModel(std::move(designModel))
+  , m_layoutJson(layoutJson)
+{
+  ASSERT(m_designModel);
+}
+
 ExpandSymbol::~ExpandSymbol()
 {
 }
@@ -81,7 +90,7 @@ std::pair<std::shared_ptr<VGG::Domain::DesignDocument>, nlohmann::json> ExpandSy
   m_designDocument->buildSubtree();
   m_layout.reset(new Layout{ m_designDocument, getLayoutRules() });
 
-  for (auto& page : m_designDocument->children())
+  for (auto& page : m_designDocument->childObjects())
   {
     if (!page->object()->visible) // skip invisible frames
       continue;
@@ -97,6 +106,7 @@ std::pair<std::shared_ptr<VGG::Domain::DesignDocument>, nlohmann::json> ExpandSy
 
 std::pair<nlohmann::json, nlohmann::json> ExpandSymbol::run()
 {
+  VGG_TRACE_ZONE("expand");
   auto [designDocument, layoutJson] = operator()();
   return { designDocument->treeModel(), std::move(layoutJson) };
 }
@@ -195,8 +205,8 @@ void ExpandSymbol::collectLayoutRules(const nlohmann::json& layoutJson)
 }
 
 void ExpandSymbol::traverseElementNode(
-  std::shared_ptr<Domain::Element>& element,
-  std::vector<std::string>&         instanceIdStack)
+  const std::shared_ptr<Domain::Element>& element,
+  std::vector<std::string>&               instanceIdStack)
 {
   if (auto instance = std::dynamic_pointer_cast<Domain::SymbolInstanceElement>(element))
   {
@@ -204,7 +214,7 @@ void ExpandSymbol::traverseElementNode(
     return;
   }
 
-  for (auto& child : element->children())
+  for (auto& child : element->childObjects())
   {
     traverseElementNode(child, instanceIdStack);
   }
@@ -284,7 +294,7 @@ void ExpandSymbol::expandInstanceElement(
   }
 
   // 1. expand
-  for (auto& child : instance.children())
+  for (auto& child : instance.childObjects())
   {
     traverseElementNode(child, instanceIdStack);
   }
@@ -296,7 +306,7 @@ void ExpandSymbol::expandInstanceElement(
   mergeLayoutRule(masterId, instanceIdWithPrefix);
 
   auto idPrefix = instanceIdWithPrefix + K_SEPARATOR;
-  for (auto child : instance.children())
+  for (auto child : instance.childObjects())
   {
     makeTreeKeysUnique(child, idPrefix);
   }
@@ -309,14 +319,14 @@ void ExpandSymbol::expandInstanceElement(
   }
 
   // 2.2. update mask by: id -> unique id
-  for (auto child : instance.children())
+  for (auto child : instance.childObjects())
   {
     makeMaskIdUnique(child, instance, idPrefix);
   }
 
   // 3 overrides and scale
   // 3.0 master id refer to a var
-  for (auto child : instance.children())
+  for (auto child : instance.childObjects())
   {
     processVariableRefs(child, instance, instanceIdStack, EProcessVarRefOption::ONLY_MASTER);
   }
@@ -325,7 +335,7 @@ void ExpandSymbol::expandInstanceElement(
 
   // 3.2: variables
   processVariableAssignmentsOverrides(instance, instanceIdStack);
-  for (auto child : instance.children())
+  for (auto child : instance.childObjects())
   {
     processVariableRefs(child, instance, instanceIdStack, EProcessVarRefOption::NOT_MASTER);
   }
@@ -343,7 +353,7 @@ void ExpandSymbol::expandInstanceElement(
   instanceIdStack.pop_back();
 
   // 4. again, makeMaskIdUnique after override: id -> unique id
-  for (auto child : instance.children())
+  for (auto child : instance.childObjects())
   {
     makeMaskIdUnique(child, instance, idPrefix);
   }
@@ -428,16 +438,7 @@ std::string ExpandSymbol::join(
   const std::vector<std::string>& instanceIdStack,
   const std::string&              separator)
 {
-  if (instanceIdStack.empty())
-  {
-    return {};
-  }
-
-  return std::accumulate(
-    std::next(instanceIdStack.begin()),
-    instanceIdStack.end(),
-    instanceIdStack[0], // start with first element
-    [&](const std::string& a, const std::string& b) { return a + separator + b; });
+  return Helper::join(instanceIdStack, separator);
 }
 
 void ExpandSymbol::mergeLayoutRule(const std::string& srcId, const std::string& dstId)
@@ -683,7 +684,7 @@ void ExpandSymbol::makeTreeKeysUnique(
     mergeLayoutRule(oldObjectId, newObjectId);
   }
 
-  for (auto child : element->children())
+  for (auto child : element->childObjects())
   {
     makeTreeKeysUnique(child, idPrefix);
   }
@@ -864,7 +865,7 @@ void ExpandSymbol::processVariableRefs(
 
   } while (false);
 
-  for (auto child : element->children())
+  for (auto child : element->childObjects())
   {
     processVariableRefs(child, container, instanceIdStack, option);
   }
@@ -895,7 +896,7 @@ void ExpandSymbol::removeInvalidLayoutRule(const Element& element, bool keepOwn)
     }
   }
 
-  for (auto child : element.children())
+  for (auto child : element.childObjects())
   {
     removeInvalidLayoutRule(*child);
   }
@@ -1041,7 +1042,7 @@ void ExpandSymbol::processVariableAssignmentsOverrides(
     }
 
     childInstance->updateVariableAssignments(overrideItem.overrideValue);
-    for (auto& child : childInstance->children())
+    for (auto child : childInstance->childObjects())
     {
       processVariableRefs(child, *childInstance, _, EProcessVarRefOption::ALL);
     }
@@ -1143,48 +1144,46 @@ void ExpandSymbol::processBoundsOverrides(
     return;
   }
 
-  std::vector<OverrideValue> boundsOverrideValues;
-  std::copy_if(
-    instanceModel->overrideValues.begin(),
-    instanceModel->overrideValues.end(),
-    std::back_inserter(boundsOverrideValues),
-    [](const OverrideValue& item) { return item.overrideName == K_BOUNDS; });
+  // look up the target elements once instead of in every comparison
+  std::vector<std::pair<const OverrideValue*, std::shared_ptr<Element>>> boundsOverrideValues;
+  for (const auto& item : instanceModel->overrideValues)
+  {
+    if (item.overrideName == K_BOUNDS)
+    {
+      std::vector<std::string> _;
+      boundsOverrideValues.emplace_back(&item, findChildObject(instance, instanceIdStack, item, _));
+    }
+  }
 
   // Sorting: Top-down, root first;
   std::stable_sort(
     boundsOverrideValues.begin(),
     boundsOverrideValues.end(),
-    [self = this, &instance, &instanceIdStack](const OverrideValue& a, const OverrideValue& b)
+    [](const auto& a, const auto& b)
     {
-      if (a.objectId.size() == b.objectId.size())
+      if (a.first->objectId.size() == b.first->objectId.size())
       {
-        std::vector<std::string> _;
-
-        auto aElement = self->findChildObject(instance, instanceIdStack, a, _);
-        auto bElement = self->findChildObject(instance, instanceIdStack, b, _);
-        if (aElement && bElement)
+        if (a.second && b.second)
         {
-          return aElement->isAncestorOf(bElement);
+          return a.second->isAncestorOf(b.second);
         }
 
         return false;
       }
       else
       {
-        return a.objectId.size() < b.objectId.size();
+        return a.first->objectId.size() < b.first->objectId.size();
       }
     });
 
-  for (auto& overrideItem : boundsOverrideValues)
+  for (auto& [item, element] : boundsOverrideValues)
   {
-    std::vector<std::string> _;
-    auto                     element = findChildObject(instance, instanceIdStack, overrideItem, _);
     if (!element)
     {
       continue;
     }
 
-    Rect newBounds = overrideItem.overrideValue;
+    Rect newBounds = item->overrideValue;
     layoutSubtree(element->id(), newBounds.size, false);
   }
 }
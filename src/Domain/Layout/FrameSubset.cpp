@@ -0,0 +1,145 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Domain/Layout/FrameSubset.hpp"
+#include "JsonKeys.hpp"
+
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace VGG::Layout
+{
+
+namespace
+{
+// A top level item of the design document, an item of "frames" or of "references"
+struct Container
+{
+  const nlohmann::json*           json{ nullptr };
+  bool                            isReference{ false };
+  std::unordered_set<std::string> masterIds; // masters used by the objects inside
+  bool                            selected{ false };
+};
+
+// Records the owner of every object id and the master ids used inside the container.
+void scan(
+  const nlohmann::json&                    j,
+  std::size_t                              container,
+  std::vector<Container>&                  containers,
+  std::unordered_map<std::string, size_t>& owners)
+{
+  if (j.is_object())
+  {
+    if (auto it = j.find(K_ID); it != j.end() && it->is_string())
+    {
+      owners.emplace(it->get<std::string>(), container);
+    }
+    if (auto it = j.find(K_MASTER_ID); it != j.end() && it->is_string())
+    {
+      containers[container].masterIds.insert(it->get<std::string>());
+    }
+    if (auto it = j.find(K_OVERRIDE_NAME); it != j.end() && *it == K_MASTER_ID)
+    {
+      // an instance swapped to another master
+      if (auto value = j.find(K_OVERRIDE_VALUE); value != j.end() && value->is_string())
+      {
+        containers[container].masterIds.insert(value->get<std::string>());
+      }
+    }
+  }
+  if (j.is_structured())
+  {
+    for (auto& value : j) // values of an object, items of an array
+    {
+      scan(value, container, containers, owners);
+    }
+  }
+}
+} // namespace
+
+nlohmann::json selectFrames(
+  const nlohmann::json&                  designDoc,
+  const std::unordered_set<std::string>& frameIds)
+{
+  const auto frames = designDoc.find(K_FRAMES);
+  if (frames == designDoc.end() || !frames->is_array())
+  {
+    return designDoc;
+  }
+  const auto references = designDoc.find(K_REFERENCES);
+
+  std::vector<Container>                  containers;
+  std::unordered_map<std::string, size_t> owners; // object id: index of the container
+  for (auto& frame : *frames)
+  {
+    containers.push_back({ &frame, false });
+    scan(frame, containers.size() - 1, containers, owners);
+  }
+  if (references != designDoc.end() && references->is_array())
+  {
+    for (auto& reference : *references)
+    {
+      containers.push_back({ &reference, true });
+      scan(reference, containers.size() - 1, containers, owners);
+    }
+  }
+
+  std::deque<std::size_t> queue;
+  for (std::size_t i = 0; i < containers.size(); ++i)
+  {
+    auto& c = containers[i];
+    if (!c.isReference && frameIds.contains(c.json->value(K_ID, K_EMPTY_STRING)))
+    {
+      c.selected = true;
+      queue.push_back(i);
+    }
+  }
+  while (!queue.empty())
+  {
+    const auto& c = containers[queue.front()];
+    queue.pop_front();
+    for (const auto& masterId : c.masterIds)
+    {
+      if (auto it = owners.find(masterId); it != owners.end() && !containers[it->second].selected)
+      {
+        containers[it->second].selected = true;
+        queue.push_back(it->second);
+      }
+    }
+  }
+
+  nlohmann::json result = nlohmann::json::object();
+  for (auto& [key, value] : designDoc.items())
+  {
+    if (key != K_FRAMES && key != K_REFERENCES)
+    {
+      result[key] = value;
+    }
+  }
+  auto& resultFrames = result[K_FRAMES] = nlohmann::json::array();
+  for (const auto& c : containers)
+  {
+    if (c.selected)
+    {
+      auto& target = c.isReference ? result[K_REFERENCES] : resultFrames;
+      target.push_back(*c.json);
+    }
+  }
+  return result;
+}
+
+} // namespace VGG::Layout
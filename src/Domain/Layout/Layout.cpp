@@ -24,6 +24,7 @@
 #include "RawJsonDocument.hpp"
 #include "Rule.hpp"
 #include "Utility/Log.hpp"
+#include "Utility/Trace.hpp"
 #include <nlohmann/json.hpp>
 
 #undef DEBUG
@@ -81,21 +82,26 @@ void Layout::Layout::layout(Size size, int pageIndex, bool updateRule, LayoutCon
     return;
   }
 
+  FrameChangeReport::Recording recording{ m_frameChangeReport.get() };
+
   // udpate page frame
   root->children()[pageIndex]->scaleTo(size, updateRule, true);
 
   // layout
+  VGG_TRACE_ZONE("layout");
   root->layoutIfNeeded(context);
 }
 
 void Layout::Layout::buildLayoutTree()
 {
   m_layoutTree.reset(new LayoutNode{ m_designDocument });
-  for (auto& child : m_designDocument->children())
+  for (auto& child : m_designDocument->childObjects())
   {
     auto page = makeTree(child, m_layoutTree.get());
     m_originalPageSize.push_back(page->frame().size);
   }
+
+  primeNodeCache(m_layoutTree.get());
 }
 
 void Layout::Layout::buildSubtree(LayoutNode* parent)
@@ -110,7 +116,7 @@ void Layout::Layout::buildSubtree(LayoutNode* parent)
     return;
   }
 
-  for (auto& child : element->children())
+  for (auto& child : element->childObjects())
   {
     makeTree(child, parent);
   }
@@ -183,6 +189,26 @@ JsonDocumentPtr Layout::Layout::displayDesignDoc()
   return result;
 }
 
+void Layout::Layout::setFrameChangeReportEnabled(bool enabled)
+{
+  if (enabled == static_cast<bool>(m_frameChangeReport))
+  {
+    return;
+  }
+
+  m_frameChangeReport = enabled ? std::make_shared<FrameChangeReport>() : nullptr;
+}
+
+std::vector<std::weak_ptr<LayoutNode>> Layout::Layout::takeChangedNodes()
+{
+  if (!m_frameChangeReport)
+  {
+    return {};
+  }
+
+  return m_frameChangeReport->take();
+}
+
 std::shared_ptr<Domain::DesignDocument> Layout::Layout::designDocTree()
 {
   updateFirstOnTop(m_designDocument);
@@ -212,6 +238,7 @@ void Layout::Layout::resizeNodeThenLayout(LayoutNode* node, Size size, bool pres
   }
 
   DEBUG("Layout::resizeNodeThenLayout: resize subtree, %s", node->id().c_str());
+  FrameChangeReport::Recording recording{ m_frameChangeReport.get() };
   auto treeToLayout = node->scaleTo(size, true, preservingOrigin);
   if (treeToLayout)
   {
@@ -264,6 +291,7 @@ void Layout::Layout::layoutNodes(
 
   if (commonAncestor)
   {
+    FrameChangeReport::Recording recording{ m_frameChangeReport.get() };
     commonAncestor->layoutIfNeeded();
   }
 }
@@ -316,7 +344,7 @@ std::shared_ptr<LayoutNode> Layout::Layout::makeTree(
     parent->addChild(node);
   }
 
-  for (auto& child : element->children())
+  for (auto& child : element->childObjects())
   {
     makeTree(child, node.get());
   }
@@ -346,7 +374,7 @@ void Layout::Layout::updateFirstOnTop(std::shared_ptr<Domain::Element> element)
     }
   }
 
-  for (auto& child : element->children())
+  for (auto& child : element->childObjects())
   {
     updateFirstOnTop(child);
   }
@@ -362,25 +390,26 @@ LayoutNode* Layout::Layout::findNodeInTreeById(LayoutNode* tree, const std::stri
   if (!tree)
     return nullptr;
 
-  if (m_nodeCacheMap.contains(id)) // cache hit
-    return m_nodeCacheMap[id];
+  if (auto it = m_nodeCacheMap.find(id); it != m_nodeCacheMap.end()) // cache hit
+  {
+    if (it->second->id() == id)
+      return it->second;
+    uncacheOneNode(it->second); // id changed after caching
+  }
 
   auto p = tree->findDescendantNodeById(id);
   if (p)
-    m_nodeCacheMap[id] = p; // cache result
+    cacheOneNode(p); // cache result
 
   return p;
 }
 
 void Layout::Layout::invalidateNodeCache(LayoutNode* tree)
 {
-  if (const auto& id = tree->id(); !id.empty())
-    m_nodeCacheMap.erase(id);
+  uncacheOneNode(tree);
 
   for (auto& child : tree->children())
     invalidateNodeCache(child.get());
-
-  // m_nodeCacheMap.clear();
 }
 
 std::vector<std::shared_ptr<LayoutNode>> Layout::Layout::removeNodeChildren(LayoutNode* node)
@@ -401,8 +430,18 @@ void Layout::Layout::cacheOneNode(LayoutNode* node)
   if (!node)
     return;
 
-  if (const auto& id = node->id(); !id.empty())
-    m_nodeCacheMap[id] = node;
+  const auto& id = node->id();
+  if (id.empty())
+    return;
+
+  if (auto it = m_nodeCacheKeys.find(node); it != m_nodeCacheKeys.end() && it->second != id)
+    uncacheOneNode(node); // cached with old id
+
+  auto& cached = m_nodeCacheMap[id];
+  if (cached && cached != node)
+    m_nodeCacheKeys.erase(cached);
+  cached = node;
+  m_nodeCacheKeys[node] = id;
 }
 
 void Layout::Layout::cacheTreeNodes(LayoutNode* tree)
@@ -410,11 +449,35 @@ void Layout::Layout::cacheTreeNodes(LayoutNode* tree)
   if (!tree)
     return;
 
-  if (const auto& id = tree->id(); !id.empty())
-    m_nodeCacheMap[id] = tree;
+  cacheOneNode(tree);
 
   for (auto& child : tree->children())
     cacheTreeNodes(child.get());
 }
 
+void Layout::Layout::uncacheOneNode(LayoutNode* node)
+{
+  auto it = m_nodeCacheKeys.find(node);
+  if (it == m_nodeCacheKeys.end())
+    return;
+
+  if (auto cacheIt = m_nodeCacheMap.find(it->second);
+      cacheIt != m_nodeCacheMap.end() && cacheIt->second == node)
+    m_nodeCacheMap.erase(cacheIt);
+  m_nodeCacheKeys.erase(it);
+}
+
+void Layout::Layout::primeNodeCache(LayoutNode* tree)
+{
+  // Keep the first node in tree order for duplicated ids, the same as a scan from the root
+  if (const auto& id = tree->id(); !id.empty())
+  {
+    if (auto [_, inserted] = m_nodeCacheMap.try_emplace(id, tree); inserted)
+      m_nodeCacheKeys[tree] = id;
+  }
+
+  for (auto& child : tree->children())
+    primeNodeCache(child.get());
+}
+
 } // namespace VGG
\ No newline at end of file
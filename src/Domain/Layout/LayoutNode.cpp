@@ -60,6 +60,22 @@ bool isInvalidLength(Layout::Scalar length)
 
 } // namespace
 
+thread_local FrameChangeReport* FrameChangeReport::s_recording{ nullptr };
+
+void FrameChangeReport::add(LayoutNode* node)
+{
+  if (m_added.insert(node).second)
+  {
+    m_nodes.push_back(node->weak_from_this());
+  }
+}
+
+std::vector<std::weak_ptr<LayoutNode>> FrameChangeReport::take()
+{
+  m_added.clear();
+  return std::move(m_nodes);
+}
+
 std::size_t LayoutNode::treeSize() const
 {
   std::size_t count = 1;
@@ -91,19 +107,51 @@ std::pair<std::shared_ptr<LayoutNode>, std::string> LayoutNode::hitTest(
       return { shared_from_this(), {} };
     }
 
-    std::vector<std::string> keys{ id(), originalId(), name() };
-    if (auto ele = elementNode(); ele && (ele->type() == Domain::Element::EType::SYMBOL_INSTANCE))
+    for (const auto& key : eventListenerKeys())
     {
-      auto s = static_cast<Domain::SymbolInstanceElement*>(ele);
-      if (!s->shouldKeepListeners())
-        keys.clear();
-      keys.insert(keys.begin(), s->masterId());
+      if (hasEventListener(key))
+      {
+        return { shared_from_this(), key };
+      }
     }
-    for (const auto& key : keys)
+  }
+
+  return {};
+}
+
+void LayoutNode::hitTestPath(const Layout::Point& point, HitPath& outPath)
+{
+  // same traversal as hitTest, without stopping at the first target
+  for (auto it = m_children.rbegin(); it != m_children.rend(); ++it)
+  {
+    if ((*it)->pointInside(point))
+    {
+      (*it)->hitTestPath(point, outPath);
+    }
+  }
+
+  if (shouldHandleEvents() && pointInside(point))
+  {
+    outPath.push_back({ shared_from_this(), eventListenerKeys() });
+  }
+}
+
+std::pair<std::shared_ptr<LayoutNode>, std::string> LayoutNode::hitTest(
+  const HitPath&     path,
+  const HitTestHook& hasEventListener)
+{
+  for (const auto& entry : path)
+  {
+    if (!hasEventListener)
+    {
+      return { entry.node, {} };
+    }
+
+    for (const auto& key : entry.keys)
     {
       if (hasEventListener(key))
       {
-        return { shared_from_this(), key };
+        return { entry.node, key };
       }
     }
   }
@@ -111,6 +159,19 @@ std::pair<std::shared_ptr<LayoutNode>, std::string> LayoutNode::hitTest(
   return {};
 }
 
+std::vector<std::string> LayoutNode::eventListenerKeys() const
+{
+  std::vector<std::string> keys{ id(), originalId(), name() };
+  if (auto ele = elementNode(); ele && (ele->type() == Domain::Element::EType::SYMBOL_INSTANCE))
+  {
+    auto s = static_cast<Domain::SymbolInstanceElement*>(ele);
+    if (!s->shouldKeepListeners())
+      keys.clear();
+    keys.insert(keys.begin(), s->masterId());
+  }
+  return keys;
+}
+
 std::shared_ptr<Layout::Internal::AutoLayout> LayoutNode::autoLayout() const
 {
   return m_autoLayout;
@@ -143,6 +204,20 @@ void LayoutNode::setNeedsLayout()
 {
   VERBOSE("LayoutNode::setNeedsLayout: node: %s", id().c_str());
   m_needsLayout = true;
+  propagate(&LayoutNode::m_descendantNeedsLayout);
+}
+
+void LayoutNode::setNeedsLayoutText()
+{
+  m_needsLayoutText = true;
+  propagate(&LayoutNode::m_descendantNeedsLayoutText);
+}
+
+void LayoutNode::propagate(bool LayoutNode::*flag)
+{
+  // stop at the first flagged ancestor, its ancestors are flagged already
+  for (auto node = this; node && !(node->*flag); node = node->m_parent.lock().get())
+    node->*flag = true;
 }
 void LayoutNode::setContainerNeedsLayout()
 {
@@ -155,11 +230,24 @@ void LayoutNode::layoutIfNeeded(LayoutContext* context)
 
   do
   {
+    // cleared first, nodes marked during this pass set them again
+    m_descendantNeedsLayout = false;
+    m_descendantNeedsLayoutText = false;
+
     for (auto& child : m_children)
+    {
+      if (!child->m_descendantNeedsLayout && !child->m_descendantNeedsLayoutText)
+        continue; // clean subtree
+
       child->layoutIfNeeded(context);
+      if (child->m_descendantNeedsLayoutText) // text waiting for its paint node
+        m_descendantNeedsLayoutText = true;
+    }
 
     updateLayoutSizeInfo();
     updateTextLayoutInfo();
+    if (m_needsLayoutText)
+      m_descendantNeedsLayoutText = true;
 
     if (m_needsLayout)
     {
@@ -170,9 +258,12 @@ void LayoutNode::layoutIfNeeded(LayoutContext* context)
       // configure container
       configureAutoLayout();
 
-      // configure child items
+      // configure child items, clean children were not visited
       for (auto child : m_children)
+      {
+        child->updateLayoutSizeInfo();
         child->configureAutoLayout();
+      }
 
       if (m_autoLayout)
         m_autoLayout->applyLayout(true);
@@ -216,12 +307,14 @@ void LayoutNode::setFrame(
     newFrame.size.height);
 
   updateModel(newFrame);
+  if (auto report = FrameChangeReport::recording())
+    report->add(this);
 
   auto element = elementNode();
   if (!element)
     return;
   if (element->type() == Domain::Element::EType::TEXT)
-    m_needsLayoutText = true;
+    setNeedsLayoutText();
 
   if (shouldSkip())
   {
@@ -1659,18 +1752,6 @@ void LayoutNode::updateLayoutSizeInfo()
   m_autoLayout->setHasFixedHeightChild(hasFixedHeightChild);
 }
 
-bool LayoutNode::hasNeedsLayoutDescendant() const
-{
-  if (needsLayout())
-    return true;
-
-  for (auto& child : m_children)
-    if (child->hasNeedsLayoutDescendant())
-      return true;
-
-  return false;
-}
-
 LayoutContext* LayoutNode::context()
 {
   if (m_context)
@@ -1686,12 +1767,14 @@ void LayoutNode::updateTextLayoutInfo()
     return;
 
   auto element = elementNode();
-  if (!element)
-    return;
-  if (element->type() != Domain::Element::EType::TEXT)
+  if (!element || element->type() != Domain::Element::EType::TEXT || !m_autoLayout ||
+      !m_autoLayout->isEnabled())
+  {
+    m_needsLayoutText = false; // nothing to do, do not keep the subtree dirty
     return;
+  }
 
-  if (auto c = context(); c && m_autoLayout && m_autoLayout->isEnabled())
+  if (auto c = context())
   {
     const auto maybePaintSize = c->nodeSize(this);
     if (maybePaintSize)
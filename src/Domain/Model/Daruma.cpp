@@ -24,12 +24,16 @@
 #include "Config.hpp"
 #include "DarumaImpl.hpp"
 #include "DesignModel.hpp"
+#include "DesignModelParser.hpp"
 #include "Domain/Model/DesignDocAdapter.hpp"
 #include "Domain/Model/Element.hpp"
+#include "Domain/Model/EventListenerTable.hpp"
 #include "Loader/DirLoader.hpp"
 #include "Loader/ZipLoader.hpp"
+#include "SnapshotCache.hpp"
 #include "SubjectJsonDocument.hpp"
 #include "Utility/Log.hpp"
+#include "Utility/Trace.hpp"
 #include "Visitor.hpp"
 #include <boost/uuid/basic_name_generator.hpp>
 #include <boost/uuid/name_generator_sha1.hpp>
@@ -52,6 +56,7 @@ namespace fs = std::filesystem;
 
 Daruma::Daruma(const MakeJsonDocFn& makeDesignDocFn, const MakeJsonDocFn& makeLayoutDocFn)
   : m_impl{ new Model::Detail::DarumaImpl }
+  , m_eventListenerTable{ std::make_shared<EventListenerTable>() }
   , m_makeDesignDocFn{ makeDesignDocFn }
   , m_makeLayoutDocFn{ makeLayoutDocFn }
 {
@@ -61,6 +66,7 @@ Daruma::~Daruma() = default;
 
 bool Daruma::load(const std::string& path)
 {
+  VGG_TRACE_ZONE("load");
   if (fs::is_regular_file(path))
   {
     m_loader.reset(new Model::ZipLoader(path));
@@ -80,6 +86,7 @@ bool Daruma::load(const std::string& path)
 
 bool Daruma::load(std::vector<char>& buffer)
 {
+  VGG_TRACE_ZONE("load");
   m_loader.reset(new Model::ZipLoader(buffer));
   return loadFiles();
 }
@@ -88,7 +95,7 @@ void Daruma::accept(VGG::Model::Visitor* visitor)
 {
   const std::lock_guard<std::mutex> lock(m_mutex);
 
-  visitor->visit(K_DESIGN_FILE_NAME, m_designDoc->content().dump());
+  visitor->visit(K_DESIGN_FILE_NAME, designDoc()->content().dump());
   visitor->visit(K_EVENT_LISTENERS_FILE_NAME, m_eventListeners.dump());
   if (m_layoutDoc && m_layoutDoc->content().is_object())
   {
@@ -132,12 +139,17 @@ bool Daruma::loadFiles()
   try
   {
     std::string fileContent;
+    m_runtimeDesignDoc.reset();
     if (m_loader->readFile(K_DESIGN_FILE_NAME, fileContent))
     {
-      auto tmpJson = json::parse(fileContent);
-      auto doc = m_makeDesignDocFn(tmpJson);
-      m_designDoc = JsonDocumentPtr(new SubjectJsonDocument(doc));
-      m_runtimeDesignDoc = m_designDoc;
+      // only the typed model is kept, the json document is built from it on first use
+      auto designModel = loadDesignModel(fileContent);
+      fileContent.clear();
+      fileContent.shrink_to_fit();
+
+      const std::lock_guard<std::mutex> lock(m_designDocMutex);
+      m_designDoc.reset();
+      m_designModel = std::move(designModel);
     }
     else
     {
@@ -175,6 +187,9 @@ bool Daruma::loadFiles()
     {
       m_eventListeners = json::object();
     }
+    ++m_eventListenersRevision;
+    m_listenerCode.clear();
+    rebuildEventListenerTable();
 
     m_resources = m_loader->resources();
 
@@ -189,6 +204,10 @@ bool Daruma::loadFiles()
 
 JsonDocumentPtr Daruma::runtimeDesignDoc()
 {
+  if (!m_runtimeDesignDoc)
+  {
+    m_runtimeDesignDoc = designDoc();
+  }
   return m_runtimeDesignDoc;
 }
 
@@ -212,11 +231,55 @@ void Daruma::setRuntimeLayoutDoc(const nlohmann::json& layoutJson)
   m_runtimeLayoutDoc = JsonDocumentPtr(new SubjectJsonDocument(doc));
 }
 
+std::unique_ptr<Model::DesignModel> Daruma::loadDesignModel(const std::string& fileContent)
+{
+  if (!m_snapshotCache)
+  {
+    return parseDesignModel(fileContent);
+  }
+
+  const auto key = SnapshotCache::keyFor(fileContent);
+  if (auto model = m_snapshotCache->load(key))
+  {
+    DEBUG("#Daruma::loadDesignModel(), load from snapshot %s", key.c_str());
+    return model;
+  }
+
+  auto model = parseDesignModel(fileContent);
+  m_snapshotCache->save(key, *model);
+  return model;
+}
+
+void Daruma::setSnapshotDir(const std::string& dir)
+{
+  if (dir.empty())
+  {
+    m_snapshotCache.reset();
+  }
+  else
+  {
+    m_snapshotCache.reset(new SnapshotCache(dir));
+  }
+}
+
 JsonDocumentPtr& Daruma::designDoc()
 {
+  const std::lock_guard<std::mutex> lock(m_designDocMutex);
+  if (!m_designDoc && m_designModel)
+  {
+    auto doc = m_makeDesignDocFn(json(*m_designModel));
+    m_designDoc = JsonDocumentPtr(new SubjectJsonDocument(doc));
+    m_designModel.reset(); // the document is edited from now on, the model would be stale
+  }
   return m_designDoc;
 }
 
+std::shared_ptr<Model::DesignModel> Daruma::designModel()
+{
+  const std::lock_guard<std::mutex> lock(m_designDocMutex);
+  return m_designModel;
+}
+
 JsonDocumentPtr& Daruma::layoutDoc()
 {
   return m_layoutDoc;
@@ -271,6 +334,7 @@ void Daruma::addEventListener(
 
   // save meta info
   typeEventListeners.push_back(item);
+  rebuildEventListenerTable();
 
   // todo, notify observer?
   // todo, edit mode, save code & meta to remote server
@@ -305,6 +369,8 @@ void Daruma::removeEventListener(
         const std::lock_guard<std::mutex> lock(m_mutex);
 
         typeEventListeners.erase(it);
+        ++m_eventListenersRevision;
+        rebuildEventListenerTable();
 
         // todo, notify observer?
         return;
@@ -313,34 +379,57 @@ void Daruma::removeEventListener(
   }
 }
 
-auto Daruma::getEventListeners(const std::string& targetKey) -> ListenersType
+std::size_t Daruma::eventListenersRevision()
 {
   const std::lock_guard<std::mutex> lock(m_mutex);
+  return m_eventListenersRevision;
+}
 
+auto Daruma::getEventListeners(const std::string& targetKey) -> ListenersType
+{
   ListenersType result{};
 
-  if (targetKey.empty() || !m_eventListeners.contains(targetKey))
-  {
-    return result;
-  }
-
-  auto& elementEventListeners = m_eventListeners[targetKey];
-  for (auto& [type, typeEventListeners] : elementEventListeners.items())
+  auto table = eventListenerTable();
+  if (auto typeListeners = table->find(targetKey))
   {
-    std::vector<std::string> listeners{};
-    for (auto it = typeEventListeners.cbegin(); it != typeEventListeners.cend(); ++it)
+    for (auto& [type, listeners] : *typeListeners)
     {
-      if (it->is_object() && it->contains(K_FILE_NAME_KEY))
+      auto& codes = result[type];
+      codes.reserve(listeners.size());
+      for (auto& listener : listeners)
       {
-        listeners.push_back(getCode((*it)[K_FILE_NAME_KEY]));
+        codes.push_back(*listener.code);
       }
     }
-    result[type] = listeners;
   }
 
   return result;
 }
 
+std::shared_ptr<const EventListenerTable> Daruma::eventListenerTable()
+{
+  const std::lock_guard<std::mutex> lock(m_eventListenerTableMutex);
+  return m_eventListenerTable;
+}
+
+void Daruma::rebuildEventListenerTable()
+{
+  auto table = std::make_shared<const EventListenerTable>(
+    m_eventListeners,
+    [this](const std::string& fileName)
+    {
+      auto& code = m_listenerCode[fileName];
+      if (!code)
+      {
+        code = std::make_shared<const std::string>(getCode(fileName));
+      }
+      return code;
+    });
+
+  const std::lock_guard<std::mutex> lock(m_eventListenerTableMutex);
+  m_eventListenerTable = std::move(table);
+}
+
 // observable
 rxcpp::observable<VGG::ModelEventPtr> Daruma::getObservable()
 {
@@ -384,9 +473,9 @@ std::string Daruma::getFrameIdByIndex(const std::size_t index) const
 {
   ASSERT(m_designDocTree);
 
-  if (index < m_designDocTree->children().size())
+  if (index < m_designDocTree->childObjects().size())
   {
-    return m_designDocTree->children()[index]->id();
+    return m_designDocTree->childObjects()[index]->id();
   }
 
   return {};
@@ -396,9 +485,9 @@ int Daruma::getFrameIndexById(const std::string& id) const
 {
   ASSERT(m_designDocTree);
 
-  for (std::size_t i = 0; i < m_designDocTree->children().size(); ++i)
+  for (std::size_t i = 0; i < m_designDocTree->childObjects().size(); ++i)
   {
-    if (m_designDocTree->children()[i]->id() == id)
+    if (m_designDocTree->childObjects()[i]->id() == id)
     {
       return i;
     }
@@ -445,7 +534,7 @@ void Daruma::getTextsTo(
     }
   }
 
-  for (auto& child : element->children())
+  for (auto& child : element->childObjects())
   {
     getTextsTo(texts, child);
   }
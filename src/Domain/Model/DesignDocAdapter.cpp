@@ -53,6 +53,7 @@ void DesignDocAdapter::updateElement(const std::string& id, const std::string& c
     const auto& patch = nlohmann::json ::parse(contentJsonString);
     j.merge_patch(patch);
     element->updateJsonModel(j);
+    element->reindex();
   }
 }
 
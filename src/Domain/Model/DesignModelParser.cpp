@@ -0,0 +1,208 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DesignModelParser.hpp"
+#include <utility>
+#include <vector>
+#include "Domain/Model/DesignModel.hpp"
+#include <nlohmann/json.hpp>
+
+namespace VGG::Model
+{
+
+namespace
+{
+constexpr auto K_FRAMES = "frames";
+constexpr auto K_REFERENCES = "references";
+
+// Same as nlohmann's dom sax parser, except the items of the top level "frames" and "references"
+// arrays, which are converted to the model once complete instead of being kept in the document.
+class DesignModelSaxHandler
+{
+  using json = nlohmann::json;
+
+public:
+  using number_integer_t = json::number_integer_t;
+  using number_unsigned_t = json::number_unsigned_t;
+  using number_float_t = json::number_float_t;
+  using string_t = json::string_t;
+  using binary_t = json::binary_t;
+
+  std::vector<Frame>         frames;
+  std::vector<ReferenceType> references;
+  json                       rest; // top level object without the streamed items
+
+  bool null()
+  {
+    handleValue(nullptr);
+    return true;
+  }
+
+  bool boolean(bool val)
+  {
+    handleValue(val);
+    return true;
+  }
+
+  bool number_integer(number_integer_t val)
+  {
+    handleValue(val);
+    return true;
+  }
+
+  bool number_unsigned(number_unsigned_t val)
+  {
+    handleValue(val);
+    return true;
+  }
+
+  bool number_float(number_float_t val, const string_t&)
+  {
+    handleValue(val);
+    return true;
+  }
+
+  bool string(string_t& val)
+  {
+    handleValue(std::move(val));
+    return true;
+  }
+
+  bool binary(binary_t& val)
+  {
+    handleValue(std::move(val));
+    return true;
+  }
+
+  bool start_object(std::size_t)
+  {
+    m_stack.push_back(handleValue(json::value_t::object));
+    return true;
+  }
+
+  bool key(string_t& val)
+  {
+    if (m_stack.size() == 1)
+    {
+      m_topLevelKey = val;
+    }
+    m_objectElement = &(*m_stack.back())[val];
+    return true;
+  }
+
+  bool end_object()
+  {
+    m_stack.pop_back();
+    if (m_stack.size() == 2 && m_stack.back() == m_streamedArray)
+    {
+      takeStreamedItem();
+    }
+    return true;
+  }
+
+  bool start_array(std::size_t)
+  {
+    auto array = handleValue(json::value_t::array);
+    if (m_stack.size() == 1 && (m_topLevelKey == K_FRAMES || m_topLevelKey == K_REFERENCES))
+    {
+      m_streamedArray = array;
+      m_streamedKey = m_topLevelKey;
+    }
+    m_stack.push_back(array);
+    return true;
+  }
+
+  bool end_array()
+  {
+    if (m_stack.back() == m_streamedArray)
+    {
+      m_streamedArray = nullptr;
+    }
+    m_stack.pop_back();
+    return true;
+  }
+
+  template<class Exception>
+  bool parse_error(std::size_t, const std::string&, const Exception& ex)
+  {
+    throw ex;
+  }
+
+private:
+  std::vector<json*> m_stack;
+  json*              m_objectElement{ nullptr };
+  std::string        m_topLevelKey;
+  json*              m_streamedArray{ nullptr };
+  std::string        m_streamedKey;
+
+  template<typename Value>
+  json* handleValue(Value&& v)
+  {
+    if (m_stack.empty())
+    {
+      rest = json(std::forward<Value>(v));
+      return &rest;
+    }
+
+    if (m_stack.back()->is_array())
+    {
+      m_stack.back()->emplace_back(std::forward<Value>(v));
+      return &m_stack.back()->back();
+    }
+
+    *m_objectElement = json(std::forward<Value>(v));
+    return m_objectElement;
+  }
+
+  void takeStreamedItem()
+  {
+    auto& item = m_streamedArray->back();
+    if (m_streamedKey == K_FRAMES)
+    {
+      frames.push_back(item.get<Frame>());
+    }
+    else
+    {
+      references.push_back(item.get<ReferenceType>());
+    }
+    m_streamedArray->erase(m_streamedArray->size() - 1);
+  }
+};
+} // namespace
+
+std::unique_ptr<DesignModel> parseDesignModel(
+  const std::string&               content,
+  nlohmann::detail::input_format_t format)
+{
+  DesignModelSaxHandler handler;
+  nlohmann::json::sax_parse(content, &handler, format);
+
+  auto model = std::make_unique<DesignModel>();
+  from_json(handler.rest, *model);
+
+  if (!handler.frames.empty())
+  {
+    model->frames = std::move(handler.frames);
+  }
+  if (model->references && !handler.references.empty())
+  {
+    *model->references = std::move(handler.references);
+  }
+
+  return model;
+}
+
+} // namespace VGG::Model
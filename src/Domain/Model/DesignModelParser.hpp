@@ -0,0 +1,37 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+#include <string>
+#include "Domain/Model/DesignModelFwd.hpp"
+#include <nlohmann/json.hpp>
+
+namespace VGG
+{
+namespace Model
+{
+
+// Parse design.json directly into the typed model without building the json document of the whole
+// file: every item of the top level "frames" and "references" arrays is converted as soon as it is
+// parsed and its json is released, so peak memory is the model plus the json of one item.
+// Throws nlohmann::json::exception on malformed input, like nlohmann::json::parse.
+std::unique_ptr<DesignModel> parseDesignModel(
+  const std::string&               content,
+  nlohmann::detail::input_format_t format = nlohmann::detail::input_format_t::json);
+
+} // namespace Model
+} // namespace VGG
@@ -16,6 +16,7 @@
 
 #include "Domain/Model/Element.hpp"
 #include <algorithm>
+#include <atomic>
 #include <optional>
 #include <variant>
 #include "Domain/Model/DesignModel.hpp"
@@ -113,6 +114,7 @@ struct ElementFactory
 // DesignDocument
 DesignDocument::DesignDocument(const Model::DesignModel& designModel)
   : Element(EType::ROOT)
+  , m_index{ std::make_unique<ElementIndex>() }
 {
   m_designModel = std::make_shared<Model::DesignModel>(designModel);
 }
@@ -136,22 +138,34 @@ void DesignDocument::buildSubtree()
 Model::DesignModel DesignDocument::treeModel(bool reverseChildrenIfFirstOnTop) const
 {
   auto retModel = *m_designModel;
-  for (auto& child : children(reverseChildrenIfFirstOnTop))
-  {
-    auto frameElement = std::dynamic_pointer_cast<FrameElement>(child);
-    if (frameElement)
+  forEachChild(
+    [&retModel, reverseChildrenIfFirstOnTop](const std::shared_ptr<Element>& child)
     {
-      retModel.frames.push_back(frameElement->treeModel(reverseChildrenIfFirstOnTop));
-    }
-  }
+      if (auto frameElement = std::dynamic_pointer_cast<FrameElement>(child))
+      {
+        retModel.frames.push_back(frameElement->treeModel(reverseChildrenIfFirstOnTop));
+      }
+    },
+    reverseChildrenIfFirstOnTop);
 
   return retModel;
 }
 
 std::shared_ptr<Element> DesignDocument::getElementByKey(const std::string& key)
 {
+  Element* found{ nullptr };
+  switch (m_index->findByIdOrName(key, nullptr, found))
+  {
+    case ElementIndex::EResult::FOUND:
+      return found->shared_from_this();
+    case ElementIndex::EResult::NOT_FOUND:
+      return nullptr;
+    default:
+      break;
+  }
+
   // design document has no object, so we need to find in its children
-  for (auto& child : children())
+  for (auto& child : childObjects())
   {
     if (auto element = child->getElementByKey(key))
     {
@@ -162,11 +176,21 @@ std::shared_ptr<Element> DesignDocument::getElementByKey(const std::string& key)
   return nullptr;
 }
 
+std::shared_ptr<Element> DesignDocument::getElementByIdNumber(int idNumber) const
+{
+  if (auto element = m_index->findByIdNumber(idNumber))
+  {
+    return element->shared_from_this();
+  }
+  return nullptr;
+}
+
 // Element
 int Element::generateId()
 {
-  static int s_id{ 0 };
-  return ++s_id;
+  // documents may be built on different threads
+  static std::atomic<int> s_id{ 0 };
+  return s_id.fetch_add(1, std::memory_order_relaxed) + 1;
 }
 
 std::shared_ptr<Element> Element::cloneTree() const
@@ -181,6 +205,7 @@ std::shared_ptr<Element> Element::cloneTree() const
 void Element::regenerateId(bool recursively)
 {
   m_idNumber = generateId();
+  reindex();
   if (recursively)
     for (auto& child : childObjects())
       child->regenerateId(recursively);
@@ -189,11 +214,86 @@ void Element::regenerateId(bool recursively)
 std::size_t Element::size() const
 {
   std::size_t count = 1;
-  for (const auto& child : children())
+  for (const auto& child : childObjects())
     count += child->size();
   return count;
 }
 
+void Element::addChild(std::shared_ptr<Element> child)
+{
+  if (!child)
+  {
+    return;
+  }
+
+  child->m_parent = weak_from_this();
+  m_children.push_back(child);
+
+  if (auto index = documentIndex())
+  {
+    index->add(child.get());
+  }
+}
+
+void Element::removeChild(const std::shared_ptr<Element>& child)
+{
+  auto it = std::find(m_children.begin(), m_children.end(), child);
+  if (it == m_children.end())
+  {
+    return;
+  }
+
+  if (auto index = documentIndex())
+  {
+    index->remove(child.get());
+  }
+
+  child->m_parent.reset();
+  m_children.erase(it);
+}
+
+std::vector<std::shared_ptr<Element>> Element::clearChildren()
+{
+  if (auto index = documentIndex())
+  {
+    for (auto& child : m_children)
+    {
+      index->remove(child.get());
+    }
+  }
+
+  for (auto& child : m_children)
+  {
+    child->m_parent.reset();
+  }
+  return std::move(m_children);
+}
+
+ElementIndex* Element::documentIndex() const
+{
+  auto root = this;
+  std::shared_ptr<Element> holder;
+  while (auto parent = root->m_parent.lock())
+  {
+    holder = std::move(parent);
+    root = holder.get();
+  }
+
+  if (root->type() != EType::ROOT)
+  {
+    return nullptr;
+  }
+  return static_cast<const DesignDocument*>(root)->index();
+}
+
+void Element::reindex()
+{
+  if (auto index = documentIndex())
+  {
+    index->reindex(this);
+  }
+}
+
 std::vector<std::shared_ptr<Element>> Element::children(bool reverseChildrenIfFirstOnTop) const
 {
   auto result = m_children;
@@ -317,6 +417,7 @@ void Element::addKeyPrefix(const std::string& prefix)
   {
     model->overrideKey = prefix + model->overrideKey.value();
   }
+  reindex();
 }
 
 void Element::makeMaskIdUnique(Domain::SymbolInstanceElement& instance, const std::string& idPrefix)
@@ -345,7 +446,7 @@ void Element::makeMaskIdUnique(Domain::SymbolInstanceElement& instance, const st
     }
   }
 
-  for (auto& child : children())
+  for (auto& child : childObjects())
   {
     child->makeMaskIdUnique(instance, idPrefix);
   }
@@ -385,10 +486,11 @@ void Element::applyOverride(
   nlohmann::json contentJson = jsonModel();
   applyOverrides(contentJson, name, value, outDirtyNodeIds);
   updateJsonModel(contentJson);
+  reindex();
 
   if (recursively)
   {
-    for (auto& child : children())
+    for (auto& child : childObjects())
     {
       child->applyOverride(name, value, outDirtyNodeIds, recursively);
     }
@@ -438,14 +540,9 @@ bool Element::isAncestorOf(const std::shared_ptr<Element>& element) const
     return false;
   }
 
-  if (this == element.get())
-  {
-    return true;
-  }
-
-  for (auto& child : children())
+  for (auto p = element; p; p = p->parent())
   {
-    if (child->isAncestorOf(element))
+    if (p.get() == this)
     {
       return true;
     }
@@ -463,32 +560,57 @@ std::shared_ptr<Element> Element::findElementByKey(
     return nullptr;
   }
 
-  auto model = object();
-  if (!model)
+  // the key is the same for the whole subtree, join it once
+  std::string firstObjectId;
+  if (outInstanceIdStack && !outInstanceIdStack->empty())
   {
-    return nullptr;
+    firstObjectId = Helper::join(*outInstanceIdStack);
+    firstObjectId.append(Helper::K_SEPARATOR).append(keyStack[0]);
   }
-
-  std::vector<std::string>  tmpInstanceIdStack;
-  std::vector<std::string>* theOutInstanceIdStack;
-  if (outInstanceIdStack)
+  else
   {
-    tmpInstanceIdStack = *outInstanceIdStack;
-    theOutInstanceIdStack = outInstanceIdStack;
+    firstObjectId = keyStack[0];
   }
-  else
+
+  return findElementByKey(keyStack, firstObjectId, outInstanceIdStack);
+}
+
+std::shared_ptr<Element> Element::findElementByKey(
+  const std::vector<std::string>& keyStack,
+  const std::string&              firstObjectId,
+  std::vector<std::string>*       outInstanceIdStack)
+{
+  auto model = object();
+  if (!model)
   {
-    theOutInstanceIdStack = &tmpInstanceIdStack;
+    return nullptr;
   }
-  tmpInstanceIdStack.push_back(keyStack[0]);
 
   // 1. find by overrideKey first; 2. find by id
-  const auto& firstObjectId = Helper::join(tmpInstanceIdStack);
+  std::shared_ptr<Element> target;
   if (
     (model->overrideKey && (model->overrideKey.value() == firstObjectId)) ||
     model->id == firstObjectId)
   {
-    auto target = shared_from_this();
+    target = shared_from_this();
+  }
+  else if (auto index = documentIndex())
+  {
+    Element* found{ nullptr };
+    switch (index->findByKey(firstObjectId, this, found))
+    {
+      case ElementIndex::EResult::FOUND:
+        target = found->shared_from_this();
+        break;
+      case ElementIndex::EResult::NOT_FOUND:
+        return nullptr;
+      default:
+        break;
+    }
+  }
+
+  if (target)
+  {
     if (keyStack.size() == 1) // is last key
     {
       return target;
@@ -497,6 +619,14 @@ std::shared_ptr<Element> Element::findElementByKey(
     {
       // the id is already prefixed: xxx__yyy__zzz;
       const auto originalId = Helper::split(target->object()->id).back();
+
+      std::vector<std::string>  tmpInstanceIdStack;
+      std::vector<std::string>* theOutInstanceIdStack = outInstanceIdStack;
+      if (!theOutInstanceIdStack)
+      {
+        tmpInstanceIdStack.push_back(keyStack[0]);
+        theOutInstanceIdStack = &tmpInstanceIdStack;
+      }
       theOutInstanceIdStack->push_back(originalId);
 
       return target->findElementByKey(
@@ -505,9 +635,9 @@ std::shared_ptr<Element> Element::findElementByKey(
     }
   }
 
-  for (auto& child : children())
+  for (auto& child : childObjects())
   {
-    if (auto found = child->findElementByKey(keyStack, outInstanceIdStack))
+    if (auto found = child->findElementByKey(keyStack, firstObjectId, outInstanceIdStack))
     {
       return found;
     }
@@ -529,7 +659,7 @@ Element* Element::findElementByRef(
 
   if (index > 0)
   {
-    for (auto& child : children())
+    for (auto& child : childObjects())
       if (
         auto found = child->findElementByRef(refTargetReversedPath, index - 1, outInstanceIdStack))
       {
@@ -577,7 +707,21 @@ std::shared_ptr<Element> Element::getElementByKey(const std::string& key)
       return shared_from_this();
     }
 
-    for (auto& child : children())
+    if (auto index = documentIndex())
+    {
+      Element* found{ nullptr };
+      switch (index->findByIdOrName(key, this, found))
+      {
+        case ElementIndex::EResult::FOUND:
+          return found->shared_from_this();
+        case ElementIndex::EResult::NOT_FOUND:
+          return nullptr;
+        default:
+          break;
+      }
+    }
+
+    for (auto& child : childObjects())
     {
       if (auto element = child->getElementByKey(key))
       {
@@ -648,12 +792,14 @@ void FrameElement::getToModel(Model::SubGeometryType& subGeometry)
 Model::Frame FrameElement::treeModel(bool reverseChildrenIfFirstOnTop) const
 {
   auto retModel = *m_frame;
-  for (auto& child : children(reverseChildrenIfFirstOnTop))
-  {
-    ContainerChildType variantModel;
-    child->getTreeToModel(variantModel, reverseChildrenIfFirstOnTop);
-    retModel.childObjects.push_back(variantModel);
-  }
+  forEachChild(
+    [&retModel, reverseChildrenIfFirstOnTop](const std::shared_ptr<Element>& child)
+    {
+      ContainerChildType variantModel;
+      child->getTreeToModel(variantModel, reverseChildrenIfFirstOnTop);
+      retModel.childObjects.push_back(variantModel);
+    },
+    reverseChildrenIfFirstOnTop);
   return retModel;
 }
 void FrameElement::getTreeToModel(
@@ -711,12 +857,14 @@ void GroupElement::getToModel(Model::SubGeometryType& subGeometry)
 Model::Group GroupElement::treeModel(bool reverseChildrenIfFirstOnTop) const
 {
   auto retModel = *m_group;
-  for (auto& child : children(reverseChildrenIfFirstOnTop))
-  {
-    ContainerChildType variantModel;
-    child->getTreeToModel(variantModel, reverseChildrenIfFirstOnTop);
-    retModel.childObjects.push_back(variantModel);
-  }
+  forEachChild(
+    [&retModel, reverseChildrenIfFirstOnTop](const std::shared_ptr<Element>& child)
+    {
+      ContainerChildType variantModel;
+      child->getTreeToModel(variantModel, reverseChildrenIfFirstOnTop);
+      retModel.childObjects.push_back(variantModel);
+    },
+    reverseChildrenIfFirstOnTop);
   return retModel;
 }
 void GroupElement::getTreeToModel(
@@ -786,12 +934,14 @@ void SymbolMasterElement::getToModel(Model::SubGeometryType& subGeometry)
 Model::SymbolMaster SymbolMasterElement::treeModel(bool reverseChildrenIfFirstOnTop) const
 {
   auto retModel = *m_master;
-  for (auto& child : children(reverseChildrenIfFirstOnTop))
-  {
-    ContainerChildType variantModel;
-    child->getTreeToModel(variantModel, reverseChildrenIfFirstOnTop);
-    retModel.childObjects.push_back(variantModel);
-  }
+  forEachChild(
+    [&retModel, reverseChildrenIfFirstOnTop](const std::shared_ptr<Element>& child)
+    {
+      ContainerChildType variantModel;
+      child->getTreeToModel(variantModel, reverseChildrenIfFirstOnTop);
+      retModel.childObjects.push_back(variantModel);
+    },
+    reverseChildrenIfFirstOnTop);
   return retModel;
 }
 void SymbolMasterElement::getTreeToModel(
@@ -927,12 +1077,14 @@ Model::SymbolMaster SymbolInstanceElement::treeModel(bool reverseChildrenIfFirst
   ASSERT(m_master);
   Model::SymbolMaster retModel;
   static_cast<Model::Object&>(retModel) = *m_instance;
-  for (auto& child : children(reverseChildrenIfFirstOnTop))
-  {
-    ContainerChildType variantModel;
-    child->getTreeToModel(variantModel, reverseChildrenIfFirstOnTop);
-    retModel.childObjects.push_back(variantModel);
-  }
+  forEachChild(
+    [&retModel, reverseChildrenIfFirstOnTop](const std::shared_ptr<Element>& child)
+    {
+      ContainerChildType variantModel;
+      child->getTreeToModel(variantModel, reverseChildrenIfFirstOnTop);
+      retModel.childObjects.push_back(variantModel);
+    },
+    reverseChildrenIfFirstOnTop);
   retModel.class_ = m_master->class_;
   retModel.radius = m_master->radius;
   return retModel;
@@ -1111,11 +1263,11 @@ nlohmann::json PathElement::jsonModel()
   ASSERT(m_path);
   if (m_path->shape)
   {
-    ASSERT(children().size() >= m_path->shape->subshapes.size());
+    ASSERT(childObjects().size() >= m_path->shape->subshapes.size());
     for (std::size_t i = 0; i < m_path->shape->subshapes.size(); i++)
     {
       auto subGeometry = std::make_shared<Model::SubGeometryType>();
-      children()[i]->getToModel(*subGeometry);
+      childObjects()[i]->getToModel(*subGeometry);
       m_path->shape->subshapes[i].subGeometry = subGeometry;
     }
   }
@@ -1131,7 +1283,7 @@ void PathElement::updateJsonModel(const nlohmann::json& newJsonModel)
     for (std::size_t i = 0; i < m_path->shape->subshapes.size(); i++)
     {
       auto& objectModel = *m_path->shape->subshapes[i].subGeometry;
-      children()[i]->updateModel(objectModel);
+      childObjects()[i]->updateModel(objectModel);
       m_path->shape->subshapes[i].subGeometry = nullptr;
     }
   }
@@ -1146,11 +1298,11 @@ Model::Path PathElement::treeModel(bool reverseChildrenIfFirstOnTop) const
   auto retModel = *m_path;
   if (m_path->shape)
   {
-    ASSERT(children().size() >= m_path->shape->subshapes.size());
+    ASSERT(childObjects().size() >= m_path->shape->subshapes.size());
     for (std::size_t i = 0; i < m_path->shape->subshapes.size(); i++)
     {
       auto variantModel = std::make_shared<SubGeometryType>();
-      children()[i]->getTreeToModel(*variantModel, reverseChildrenIfFirstOnTop);
+      childObjects()[i]->getTreeToModel(*variantModel, reverseChildrenIfFirstOnTop);
       retModel.shape->subshapes[i].subGeometry = variantModel;
     }
     if (reverseChildrenIfFirstOnTop && isFirstOnTop())
@@ -0,0 +1,261 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Domain/Model/ElementIndex.hpp"
+#include <algorithm>
+#include "Domain/Model/DesignModel.hpp"
+#include "Domain/Model/Element.hpp"
+#include "Utility/Log.hpp"
+
+#undef DEBUG
+#define DEBUG(msg, ...)
+
+namespace VGG::Domain
+{
+
+namespace
+{
+bool isInScope(const Element* element, const Element* scope)
+{
+  if (!scope)
+  {
+    return true;
+  }
+
+  for (auto p = element; p; p = p->parent().get())
+  {
+    if (p == scope)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
+void ElementIndex::add(Element* tree)
+{
+  if (!tree)
+  {
+    return;
+  }
+
+  addOne(tree);
+  for (auto& child : tree->childObjects())
+  {
+    add(child.get());
+  }
+}
+
+void ElementIndex::remove(Element* tree)
+{
+  if (!tree)
+  {
+    return;
+  }
+
+  removeOne(tree);
+  for (auto& child : tree->childObjects())
+  {
+    remove(child.get());
+  }
+}
+
+void ElementIndex::reindex(Element* element)
+{
+  if (!element || !m_keys.contains(element))
+  {
+    return;
+  }
+
+  removeOne(element);
+  addOne(element);
+}
+
+void ElementIndex::clear()
+{
+  m_keys.clear();
+  m_ids.clear();
+  m_names.clear();
+  m_overrideKeys.clear();
+  m_idNumbers.clear();
+}
+
+ElementIndex::EResult ElementIndex::findByIdOrName(
+  const std::string& key,
+  const Element*     scope,
+  Element*&          outElement)
+{
+  std::vector<Element*> candidates;
+  collect(m_ids, key, candidates);
+  collect(m_names, key, candidates);
+  return pick(key, candidates, scope, outElement);
+}
+
+ElementIndex::EResult ElementIndex::findByKey(
+  const std::string& key,
+  const Element*     scope,
+  Element*&          outElement)
+{
+  std::vector<Element*> candidates;
+  collect(m_overrideKeys, key, candidates);
+  collect(m_ids, key, candidates);
+  return pick(key, candidates, scope, outElement);
+}
+
+Element* ElementIndex::findByIdNumber(int idNumber) const
+{
+  if (auto it = m_idNumbers.find(idNumber); it != m_idNumbers.end())
+  {
+    return it->second;
+  }
+  return nullptr;
+}
+
+void ElementIndex::addOne(Element* element)
+{
+  auto model = element->object();
+  if (!model)
+  {
+    return;
+  }
+
+  if (m_keys.contains(element))
+  {
+    removeOne(element);
+  }
+
+  auto& keys = m_keys[element];
+  keys.id = model->id;
+  keys.name = model->name;
+  keys.overrideKey = model->overrideKey;
+  keys.idNumber = element->idNumber();
+
+  m_ids.emplace(keys.id, element);
+  if (keys.name)
+  {
+    m_names.emplace(*keys.name, element);
+  }
+  if (keys.overrideKey)
+  {
+    m_overrideKeys.emplace(*keys.overrideKey, element);
+  }
+  m_idNumbers[keys.idNumber] = element;
+}
+
+void ElementIndex::removeOne(const Element* element)
+{
+  auto it = m_keys.find(element);
+  if (it == m_keys.end())
+  {
+    return;
+  }
+
+  const auto& keys = it->second;
+  eraseFrom(m_ids, keys.id, element);
+  if (keys.name)
+  {
+    eraseFrom(m_names, *keys.name, element);
+  }
+  if (keys.overrideKey)
+  {
+    eraseFrom(m_overrideKeys, *keys.overrideKey, element);
+  }
+  if (auto numberIt = m_idNumbers.find(keys.idNumber);
+      numberIt != m_idNumbers.end() && numberIt->second == element)
+  {
+    m_idNumbers.erase(numberIt);
+  }
+
+  m_keys.erase(it);
+}
+
+void ElementIndex::collect(
+  const Map&             map,
+  const std::string&     key,
+  std::vector<Element*>& outCandidates)
+{
+  auto [begin, end] = map.equal_range(key);
+  for (auto it = begin; it != end; ++it)
+  {
+    if (std::find(outCandidates.begin(), outCandidates.end(), it->second) == outCandidates.end())
+    {
+      outCandidates.push_back(it->second);
+    }
+  }
+}
+
+ElementIndex::EResult ElementIndex::pick(
+  const std::string&     key,
+  std::vector<Element*>& candidates,
+  const Element*         scope,
+  Element*&              outElement)
+{
+  outElement = nullptr;
+
+  auto result = EResult::NOT_FOUND;
+  for (auto candidate : candidates)
+  {
+    if (!isValid(candidate, key))
+    {
+      // the model was replaced without reindexing; tree order scan will find the right one
+      DEBUG("ElementIndex::pick: stale key %s", key.c_str());
+      reindex(candidate);
+      return EResult::AMBIGUOUS;
+    }
+
+    if (!isInScope(candidate, scope))
+    {
+      continue;
+    }
+
+    if (outElement)
+    {
+      return EResult::AMBIGUOUS;
+    }
+
+    outElement = candidate;
+    result = EResult::FOUND;
+  }
+
+  return result;
+}
+
+bool ElementIndex::isValid(const Element* element, const std::string& key) const
+{
+  auto model = element->object();
+  if (!model)
+  {
+    return false;
+  }
+
+  return model->id == key || model->name == key || model->overrideKey == key;
+}
+
+void ElementIndex::eraseFrom(Map& map, const std::string& key, const Element* element)
+{
+  auto [begin, end] = map.equal_range(key);
+  for (auto it = begin; it != end; ++it)
+  {
+    if (it->second == element)
+    {
+      map.erase(it);
+      return;
+    }
+  }
+}
+
+} // namespace VGG::Domain
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Domain/Model/EventListenerTable.hpp"
+#include "Config.hpp"
+
+namespace VGG::Model
+{
+
+EventListenerTable::EventListenerTable(
+  const nlohmann::json&  eventListeners,
+  const CodeForFileName& codeFor)
+{
+  if (!eventListeners.is_object())
+  {
+    return;
+  }
+
+  for (auto& [targetKey, elementEventListeners] : eventListeners.items())
+  {
+    if (targetKey.empty() || !elementEventListeners.is_object())
+    {
+      continue;
+    }
+
+    TypeListeners typeListeners;
+    for (auto& [type, typeEventListeners] : elementEventListeners.items())
+    {
+      if (!typeEventListeners.is_array())
+      {
+        continue;
+      }
+
+      Listeners listeners;
+      for (auto& item : typeEventListeners)
+      {
+        if (item.is_object() && item.contains(K_FILE_NAME_KEY) && item[K_FILE_NAME_KEY].is_string())
+        {
+          auto fileName = item[K_FILE_NAME_KEY].get<std::string>();
+          auto code = codeFor(fileName);
+          listeners.push_back({ std::move(fileName), std::move(code) });
+        }
+      }
+
+      // removed listeners leave empty arrays behind, they must not make the target hit testable
+      if (!listeners.empty())
+      {
+        typeListeners.emplace(type, std::move(listeners));
+      }
+    }
+
+    if (!typeListeners.empty())
+    {
+      m_listeners.emplace(targetKey, std::move(typeListeners));
+    }
+  }
+}
+
+auto EventListenerTable::find(const std::string& targetKey) const -> const TypeListeners*
+{
+  if (auto it = m_listeners.find(targetKey); it != m_listeners.end())
+  {
+    return &it->second;
+  }
+  return nullptr;
+}
+
+auto EventListenerTable::find(const std::string& targetKey, const std::string& type) const
+  -> const Listeners*
+{
+  if (auto typeListeners = find(targetKey))
+  {
+    if (auto it = typeListeners->find(type); it != typeListeners->end())
+    {
+      return &it->second;
+    }
+  }
+  return nullptr;
+}
+
+} // namespace VGG::Model
@@ -0,0 +1,187 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SnapshotCache.hpp"
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include "DesignModelParser.hpp"
+#include "Domain/Model/DesignModel.hpp"
+#include "Utility/Log.hpp"
+#include "VGGVersion_generated.h"
+#include <boost/uuid/name_generator_sha1.hpp>
+#include <boost/uuid/uuid_io.hpp>
+#include <nlohmann/json.hpp>
+
+#undef DEBUG
+#define DEBUG(msg, ...)
+
+namespace VGG::Model
+{
+
+namespace
+{
+constexpr auto K_SNAPSHOT_FILE_SUFFIX = ".vggsnap";
+
+// first line of a snapshot, the MessagePack model follows
+std::string header()
+{
+  return std::string{ "vggsnap " } + std::to_string(SnapshotCache::K_FORMAT_VERSION) + ' ' +
+         VGG_PARSE_FORMAT_VER_STR;
+}
+
+void removeFile(const std::filesystem::path& path)
+{
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+}
+} // namespace
+
+SnapshotCache::SnapshotCache(std::filesystem::path dir)
+  : m_dir{ std::move(dir) }
+{
+}
+
+std::string SnapshotCache::keyFor(const std::string& designFileContent)
+{
+  boost::uuids::name_generator_sha1 generator{ boost::uuids::ns::oid() };
+  return boost::uuids::to_string(generator(designFileContent));
+}
+
+std::unique_ptr<DesignModel> SnapshotCache::load(const std::string& key) const
+{
+  const auto path = pathFor(key);
+
+  std::ifstream file{ path, std::ios::binary };
+  if (!file)
+  {
+    DEBUG("SnapshotCache::load: miss, %s", key.c_str());
+    return nullptr;
+  }
+
+  std::string fileHeader;
+  if (!std::getline(file, fileHeader) || fileHeader != header())
+  {
+    INFO("SnapshotCache::load: drop snapshot of another version, %s", path.c_str());
+    file.close();
+    removeFile(path);
+    return nullptr;
+  }
+
+  std::string content{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+  try
+  {
+    auto model = parseDesignModel(content, nlohmann::json::input_format_t::msgpack);
+
+    // the most recently used snapshots are kept by evict()
+    std::error_code ec;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+    return model;
+  }
+  catch (const std::exception& e)
+  {
+    WARN("SnapshotCache::load: drop unreadable snapshot %s, %s", path.c_str(), e.what());
+    file.close();
+    removeFile(path);
+    return nullptr;
+  }
+}
+
+bool SnapshotCache::save(const std::string& key, const DesignModel& model) const
+{
+  std::error_code ec;
+  std::filesystem::create_directories(m_dir, ec);
+  if (ec)
+  {
+    WARN("SnapshotCache::save: create dir failed, %s", ec.message().c_str());
+    return false;
+  }
+
+  // write to a temporary file then rename, readers never see a partial snapshot
+  const auto path = pathFor(key);
+  auto       tmpPath = path;
+  tmpPath += ".tmp";
+  {
+    std::ofstream file{ tmpPath, std::ios::binary | std::ios::trunc };
+    if (!file)
+    {
+      WARN("SnapshotCache::save: open file failed, %s", tmpPath.c_str());
+      return false;
+    }
+
+    file << header() << '\n';
+    const nlohmann::json j = model;
+    nlohmann::json::to_msgpack(j, file);
+    if (!file)
+    {
+      WARN("SnapshotCache::save: write file failed, %s", tmpPath.c_str());
+      file.close();
+      removeFile(tmpPath);
+      return false;
+    }
+  }
+
+  std::filesystem::rename(tmpPath, path, ec);
+  if (ec)
+  {
+    WARN("SnapshotCache::save: rename failed, %s", ec.message().c_str());
+    removeFile(tmpPath);
+    return false;
+  }
+
+  DEBUG("SnapshotCache::save: %s", path.c_str());
+  evict();
+  return true;
+}
+
+std::filesystem::path SnapshotCache::pathFor(const std::string& key) const
+{
+  return m_dir / (key + K_SNAPSHOT_FILE_SUFFIX);
+}
+
+void SnapshotCache::evict() const
+{
+  using Snapshot = std::pair<std::filesystem::file_time_type, std::filesystem::path>;
+
+  std::error_code       ec;
+  std::vector<Snapshot> snapshots;
+  for (const auto& entry : std::filesystem::directory_iterator(m_dir, ec))
+  {
+    if (entry.path().extension() == K_SNAPSHOT_FILE_SUFFIX)
+    {
+      snapshots.emplace_back(entry.last_write_time(ec), entry.path());
+    }
+  }
+  if (snapshots.size() <= K_MAX_SNAPSHOTS)
+  {
+    return;
+  }
+
+  // newest first
+  std::sort(snapshots.begin(), snapshots.end(), std::greater<>());
+  for (auto i = K_MAX_SNAPSHOTS; i < snapshots.size(); ++i)
+  {
+    DEBUG("SnapshotCache::evict: %s", snapshots[i].second.c_str());
+    removeFile(snapshots[i].second);
+  }
+}
+
+} // namespace VGG::Model
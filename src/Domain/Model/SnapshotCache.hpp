@@ -0,0 +1,56 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include "Domain/Model/DesignModelFwd.hpp"
+
+namespace VGG
+{
+namespace Model
+{
+
+// Binary snapshots of parsed design models, one MessagePack file per design.json content, so
+// reopening an unchanged file reads a compact binary model instead of parsing the json text.
+// Every snapshot starts with a header of the snapshot format and the model format versions; one
+// written by another version is removed instead of being read.
+class SnapshotCache
+{
+public:
+  // Bump when the layout of the snapshot or the generated DesignModel changes.
+  static constexpr int K_FORMAT_VERSION = 1;
+  // The least recently used snapshots are removed above this count.
+  static constexpr std::size_t K_MAX_SNAPSHOTS = 64;
+
+  explicit SnapshotCache(std::filesystem::path dir);
+
+  static std::string keyFor(const std::string& designFileContent);
+
+  std::unique_ptr<DesignModel> load(const std::string& key) const; // nullptr: miss or unreadable
+  bool                         save(const std::string& key, const DesignModel& model) const;
+
+private:
+  std::filesystem::path m_dir;
+
+  std::filesystem::path pathFor(const std::string& key) const;
+  void                  evict() const;
+};
+
+} // namespace Model
+} // namespace VGG
@@ -48,6 +48,7 @@ public:
     return true;
   }
   virtual bool evalModule(
+    const std::string&       handlerKey,
     const std::string&       code,
     VGG::EventPtr            event,
     std::shared_ptr<IVggEnv> env)
@@ -55,6 +56,17 @@ public:
     DEBUG("FakeJsEngine::evalModule, do nothing");
     return true;
   }
+  virtual void clearModuleCache()
+  {
+  }
+  virtual bool postEvent(
+    const std::string&       event,
+    const std::string&       coalesceKey,
+    std::shared_ptr<IVggEnv> env)
+  {
+    DEBUG("FakeJsEngine::postEvent, do nothing");
+    return true;
+  }
 };
 class FakePlatformComposer : public PlatformComposer
 {
@@ -182,7 +194,17 @@ public:
 
   void dispatch() override
   {
-    m_mainComposer->runLoop()->dispatch();
+    m_mainComposer->runLoop()->dispatch(m_application->frameBudget());
+  }
+
+  std::optional<std::chrono::steady_clock::time_point> nextWakeUp() override
+  {
+    return m_application->nextWakeUp();
+  }
+
+  uint64_t missedFrames() override
+  {
+    return m_application->missedFrames();
   }
 
   bool onEvent(UEvent evt) override
@@ -13,12 +13,15 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#ifdef VGG_USE_VULKAN
 #include "ContextVk.hpp"
+#include "Layer/Graphics/ContextInfoVulkan.hpp"
+#include "Layer/Graphics/VSkiaVK.hpp"
+#endif
+#include "RowEncoder.hpp"
 #include "Domain/Layout/Rule.hpp"
 #include "Layer/Exporter/ImageExporter.hpp"
 #include "Layer/Renderer.hpp"
-#include "Layer/Graphics/ContextInfoVulkan.hpp"
-#include "Layer/Graphics/VSkiaVK.hpp"
 #include "Layer/Core/DefaultResourceProvider.hpp"
 #include "Layer/Core/ResourceManager.hpp"
 #include "Layer/Core/VUtils.hpp"
@@ -39,6 +42,9 @@
 #include "VGG/Exporter/PDFExporter.hpp"
 #include "VGG/Exporter/Type.hpp"
 
+#include <core/SkBBHFactory.h>
+#include <core/SkGraphics.h>
+#include <core/SkPictureRecorder.h>
 #include <gpu/GrRecordingContext.h>
 #include <src/gpu/ganesh/gl/GrGLDefines.h>
 #include <gpu/gl/GrGLInterface.h>
@@ -58,9 +64,20 @@
 #include <string>
 #include <sstream>
 #include <thread>
+#include <limits>
+#include <deque>
+#include <future>
+#include <atomic>
+#include <unordered_map>
+#include <unordered_set>
 
-static constexpr int MAX_WIDTH = 8192;
-static constexpr int MAX_HEIGHT = 8192;
+static constexpr int         MAX_WIDTH = 8192;
+static constexpr int         MAX_HEIGHT = 8192;
+static constexpr int         MIN_BAND_HEIGHT = 256; // cpu backend, rows rastered by one thread
+static constexpr int         MIN_SURFACE_SIDE = 256;
+static constexpr int         MAX_BAND_PIXELS = 1 << 22; // streamed export, pixels of one band
+static constexpr std::size_t MAX_POOLED_SURFACES = 4;
+static constexpr std::size_t DEFAULT_POOLED_SURFACE_BYTES = 256 << 20; // without a memory limit
 namespace VGG::exporter
 {
 
@@ -140,25 +157,152 @@ layer::EImageEncode toEImageEncode(EImageType type)
       return layer::EImageEncode::IE_JPEG;
     case WEBP:
       return layer::EImageEncode::IE_WEBP;
+    case RAW:
+      return layer::EImageEncode::IE_RAW;
     default:
       return layer::EImageEncode::IE_PNG;
   }
 }
 
+layer::EPixelFormat toEPixelFormat(EPixelFormat format)
+{
+  return format == EPixelFormat::BGRA_8888 ? layer::EPixelFormat::BGRA_8888
+                                           : layer::EPixelFormat::RGBA_8888;
+}
+
+layer::EEncodeProfile toEEncodeProfile(EEncodeProfile profile)
+{
+  switch (profile)
+  {
+    case EEncodeProfile::FAST:
+      return layer::EEncodeProfile::FAST;
+    case EEncodeProfile::BALANCED:
+      return layer::EEncodeProfile::BALANCED;
+    case EEncodeProfile::SMALLEST:
+      return layer::EEncodeProfile::SMALLEST;
+    default:
+      return layer::EEncodeProfile::DEFAULT;
+  }
+}
+
+// Flat opaque frames of the SMALLEST png profile as indexed color, one byte per pixel instead of
+// four before deflate. Skia has no palette encoder, the rows go through PngRowEncoder.
+std::optional<std::vector<char>> encodeIndexedPng(const layer::ImageOptions& opts, SkImage* image)
+{
+  SkPixmap pixmap;
+  if (
+    opts.encode != layer::EImageEncode::IE_PNG ||
+    opts.profile != layer::EEncodeProfile::SMALLEST || !image->peekPixels(&pixmap))
+  {
+    return std::nullopt;
+  }
+  std::vector<uint32_t> palette;
+  const auto            stats = layer::exporter::analyzeColors(pixmap, &palette);
+  if (!stats.opaque || palette.empty() || stats.colorCount > layer::exporter::MAX_PALETTE_COLORS)
+  {
+    return std::nullopt;
+  }
+
+  std::sort(palette.begin(), palette.end());
+  std::unordered_map<uint32_t, uint8_t> indices;
+  for (std::size_t i = 0; i < palette.size(); ++i)
+  {
+    indices[palette[i]] = static_cast<uint8_t>(i);
+  }
+
+  std::vector<char> out;
+  auto              encoder = PngRowEncoder::makeIndexed(
+    pixmap.width(),
+    pixmap.height(),
+    9,
+    palette,
+    [&out](const char* data, std::size_t size)
+    {
+      out.insert(out.end(), data, data + size);
+      return true;
+    });
+  const bool           bgra = pixmap.colorType() == kBGRA_8888_SkColorType;
+  std::vector<uint8_t> row(pixmap.width());
+  uint32_t             last = 0;
+  uint8_t              lastIndex = indices.begin()->second;
+  bool                 first = true;
+  for (int y = 0; y < pixmap.height(); ++y)
+  {
+    auto p = static_cast<const uint8_t*>(pixmap.addr(0, y));
+    for (int x = 0; x < pixmap.width(); ++x, p += 4)
+    {
+      const uint32_t c = ((bgra ? p[2] : p[0]) << 16) | (p[1] << 8) | (bgra ? p[0] : p[2]);
+      if (first || c != last)
+      {
+        lastIndex = indices[c];
+        last = c;
+        first = false;
+      }
+      row[x] = lastIndex;
+    }
+    if (!encoder->writeRows(row.data(), row.size(), 1))
+    {
+      return std::nullopt;
+    }
+  }
+  if (!encoder->finish())
+  {
+    return std::nullopt;
+  }
+  return out;
+}
+
+// encodeSnapshot with the encoders which are only available on this side
+std::optional<std::vector<char>> encodeFrame(const layer::ImageOptions& opts, SkImage* image)
+{
+  if (auto data = encodeIndexedPng(opts, image))
+  {
+    return data;
+  }
+  return layer::exporter::encodeSnapshot(opts, image);
+}
+
 class Exporter__pImpl
 {
   Exporter* q_api; // NOLINT
 public:
+  EBackend backend;
+#ifdef VGG_USE_VULKAN
   std::shared_ptr<VkGraphicsContext> ctx;
   sk_sp<GrRecordingContext>          grRecordingContext;
   SurfaceCreateProc                  proc;
+#endif
+  int threadCount{ 1 }; // cpu raster threads
 
-  sk_sp<SkSurface> surface;
+  // Render targets pooled by size class, see acquireSurface
+  struct PooledSurface
+  {
+    sk_sp<SkSurface> surface;
+    uint64_t         lastUse{ 0 };
+  };
+  std::vector<PooledSurface> surfaces;
+  uint64_t                   useCount{ 0 };
+  std::size_t                memoryLimit{ 0 }; // see Exporter::setMemoryLimit
 
   OutputCallback outputCallback;
-  Exporter__pImpl(Exporter* api)
+  Exporter__pImpl(Exporter* api, EBackend backend)
     : q_api(api)
+    , backend(backend)
   {
+#ifndef VGG_USE_VULKAN
+    if (backend == EBackend::VULKAN)
+    {
+      WARN("Exporter is built without vulkan, use the cpu backend");
+      this->backend = EBackend::CPU;
+    }
+#endif
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+    if (this->backend == EBackend::CPU)
+    {
+      return;
+    }
+
+#ifdef VGG_USE_VULKAN
     layer::ContextConfig cfg;
     ctx = std::make_shared<VkGraphicsContext>();
     cfg.stencilBit = 8;
@@ -168,30 +312,242 @@ public:
       VGG::layer::skia_impl::vk::vkContextCreateProc((ContextInfoVulkan*)ctx->contextInfo())();
     ASSERT(grRecordingContext);
     proc = VGG::layer::skia_impl::vk::vkSurfaceCreateProc();
+#endif
+  }
+
+  static int sizeClass(int side, int maxSide)
+  {
+    int s = MIN_SURFACE_SIDE;
+    while (s < side && s < maxSide)
+    {
+      s *= 2;
+    }
+    return s;
   }
 
-  void resize(int w, int h)
+  sk_sp<SkSurface> makeSurface(int w, int h)
   {
+    if (backend == EBackend::CPU)
+    {
+      // no msaa, the raster backend uses analytic anti-aliasing
+      return SkSurfaces::Raster(SkImageInfo::MakeN32Premul(w, h));
+    }
+#ifdef VGG_USE_VULKAN
     ASSERT(ctx);
-    if (!surface || (w != surface->width() || h != surface->height()))
+    return proc(grRecordingContext.get(), w, h, ctx->config());
+#else
+    return nullptr;
+#endif
+  }
+
+  // A surface of at least w x h. Sides are rounded up to a power of two so that frames of similar
+  // sizes share one surface; the least recently used one is dropped when the pool is full.
+  SkSurface* acquireSurface(int w, int h)
+  {
+    const int cw = sizeClass(w, MAX_WIDTH);
+    const int ch = sizeClass(h, MAX_HEIGHT);
+    ++useCount;
+    for (auto& s : surfaces)
+    {
+      if (s.surface->width() == cw && s.surface->height() == ch)
+      {
+        s.lastUse = useCount;
+        return s.surface.get();
+      }
+    }
+
+    auto surface = makeSurface(cw, ch);
+    if (!surface)
     {
-      surface = proc(grRecordingContext.get(), w, h, ctx->config());
-      ASSERT(surface);
+      WARN("Exporter: failed to create a %d x %d surface", cw, ch);
+      return nullptr;
     }
+    if (surfaces.size() >= MAX_POOLED_SURFACES)
+    {
+      surfaces.erase(std::min_element(
+        surfaces.begin(),
+        surfaces.end(),
+        [](const auto& a, const auto& b) { return a.lastUse < b.lastUse; }));
+    }
+    surfaces.push_back({ std::move(surface), useCount });
+    auto acquired = surfaces.back().surface.get();
+    trimSurfaces(acquired);
+    return acquired;
   }
 
-  std::optional<std::vector<char>> render(
-    layer::Ref<layer::FrameNode> f,
-    float                        scale,
-    const layer::ImageOptions&   opts,
-    IteratorResult::TimeCost&    cost)
+  // Drops the least recently used surfaces while the pool is over its half of the memory limit, or
+  // over DEFAULT_POOLED_SURFACE_BYTES without one. The size is approximated by the pixels, without
+  // msaa.
+  void trimSurfaces(const SkSurface* keep = nullptr)
+  {
+    const auto  budget = memoryLimit > 0 ? memoryLimit / 2 : DEFAULT_POOLED_SURFACE_BYTES;
+    std::size_t total = 0;
+    for (const auto& s : surfaces)
+    {
+      total += s.surface->imageInfo().computeMinByteSize();
+    }
+    while (total > budget)
+    {
+      auto victim = surfaces.end();
+      for (auto it = surfaces.begin(); it != surfaces.end(); ++it)
+      {
+        if (
+          it->surface.get() != keep &&
+          (victim == surfaces.end() || it->lastUse < victim->lastUse))
+        {
+          victim = it;
+        }
+      }
+      if (victim == surfaces.end())
+      {
+        break;
+      }
+      total -= victim->surface->imageInfo().computeMinByteSize();
+      surfaces.erase(victim);
+    }
+  }
+
+  // The picture has an R-tree so that playing it back into a band skips what is outside of it.
+  static sk_sp<SkPicture> recordFrame(layer::FrameNode* f, float scale, int w, int h)
+  {
+    SkRTreeFactory    bbhFactory;
+    SkPictureRecorder rec;
+    auto              recCanvas = rec.beginRecording(SkRect::MakeWH(w, h), &bbhFactory);
+    layer::Renderer   r;
+    recCanvas->scale(scale, scale);
+    const auto& b = f->bounds();
+    recCanvas->translate(-b.x(), -b.y());
+    r.setCanvas(recCanvas);
+    f->render(&r);
+    return rec.finishRecordingAsPicture();
+  }
+
+  // Records the frame once and plays it back in horizontal bands, one band per thread.
+  void renderRaster(
+    SkSurface*                 surface,
+    layer::FrameNode*          f,
+    float                      scale,
+    const layer::ImageOptions& opts)
+  {
+    const int w = opts.extend[0];
+    const int h = opts.extend[1];
+    auto      picture = recordFrame(f, scale, w, h);
+
+    // The pixels are written behind the canvas, detach a snapshot that may still be encoding
+    surface->notifyContentWillChange(SkSurface::kDiscard_ContentChangeMode);
+    SkPixmap pixmap;
+    if (!surface->peekPixels(&pixmap))
+    {
+      WARN("Exporter: failed to access the raster surface pixels");
+      return;
+    }
+
+    const int bandCount = std::clamp(h / MIN_BAND_HEIGHT, 1, threadCount);
+    const int bandHeight = (h + bandCount - 1) / bandCount;
+    auto      drawBand = [&](int top)
+    {
+      const auto info = pixmap.info().makeWH(w, std::min(bandHeight, h - top));
+      auto       canvas =
+        SkCanvas::MakeRasterDirect(info, pixmap.writable_addr(0, top), pixmap.rowBytes());
+      canvas->clear(SK_ColorWHITE);
+      canvas->translate(0, -top);
+      canvas->drawPicture(picture);
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 1; i < bandCount && i * bandHeight < h; ++i)
+    {
+      workers.emplace_back(drawBand, i * bandHeight);
+    }
+    drawBand(0);
+    for (auto& worker : workers)
+    {
+      worker.join();
+    }
+  }
+
+  // Renders w x h pixels band by band on the cpu threads and passes the rows to the encoder in
+  // order. Memory is bounded by the bands in flight, not by the image size.
+  bool renderStreamed(
+    layer::FrameNode* f,
+    float             scale,
+    int               w,
+    int               h,
+    SkColorType       colorType,
+    RowEncoder&       encoder)
+  {
+    auto picture = recordFrame(f, scale, w, h);
+
+    const int  bandHeight = std::clamp(MAX_BAND_PIXELS / std::max(w, 1), 1, MAX_HEIGHT);
+    const auto info = SkImageInfo::Make(w, bandHeight, colorType, kPremul_SkAlphaType);
+    const std::size_t                 rowBytes = info.minRowBytes();
+    std::vector<std::vector<uint8_t>> bands(threadCount);
+    auto                              drawBand = [&](int index, int top)
+    {
+      auto& pixels = bands[index];
+      pixels.resize(rowBytes * bandHeight);
+      auto canvas = SkCanvas::MakeRasterDirect(
+        info.makeWH(w, std::min(bandHeight, h - top)),
+        pixels.data(),
+        rowBytes);
+      canvas->clear(SK_ColorWHITE); // opaque, so the premultiplied pixels are unpremultiplied too
+      canvas->translate(0, -top);
+      canvas->drawPicture(picture);
+    };
+
+    for (int top = 0; top < h; top += bandHeight * threadCount)
+    {
+      const int count = std::min(threadCount, (h - top + bandHeight - 1) / bandHeight);
+      std::vector<std::thread> workers;
+      for (int i = 1; i < count; ++i)
+      {
+        workers.emplace_back(drawBand, i, top + i * bandHeight);
+      }
+      drawBand(0, top);
+      for (auto& worker : workers)
+      {
+        worker.join();
+      }
+
+      for (int i = 0; i < count; ++i)
+      {
+        const int rows = std::min(bandHeight, h - top - i * bandHeight);
+        if (!encoder.writeRows(bands[i].data(), rowBytes, rows))
+        {
+          return false;
+        }
+      }
+    }
+    return encoder.finish();
+  }
+
+  // Renders the frame into a pooled surface, the target rect is at the origin.
+  SkSurface* draw(
+    layer::FrameNode*          f,
+    float                      scale,
+    const layer::ImageOptions& opts,
+    IteratorResult::TimeCost&  cost)
   {
+    auto surface = acquireSurface(opts.extend[0], opts.extend[1]);
+    if (!surface)
+    {
+      return nullptr;
+    }
+
+    if (backend == EBackend::CPU)
+    {
+      layer::ScopedTimer t([&](auto d) { cost.render = d.s(); });
+      f->revalidate();
+      renderRaster(surface, f, scale, opts);
+    }
+    else
     {
       layer::ScopedTimer t([&](auto d) { cost.render = d.s(); });
       auto               canvas = surface->getCanvas();
       layer::Renderer    r;
-      canvas->clear(SK_ColorWHITE);
       canvas->save();
+      canvas->clipRect(SkRect::MakeWH(opts.extend[0], opts.extend[1]));
+      canvas->clear(SK_ColorWHITE); // only the target rect, clear respects the clip
       canvas->scale(scale, scale);
       const auto& b = f->bounds();
       canvas->translate(-b.x(), -b.y());
@@ -201,14 +557,52 @@ public:
       canvas->restore();
       canvas->flush();
     }
+    return surface;
+  }
+
+  std::optional<std::vector<char>> render(
+    layer::Ref<layer::FrameNode> f,
+    float                        scale,
+    const layer::ImageOptions&   opts,
+    IteratorResult::TimeCost&    cost)
+  {
+    auto surface = draw(f.get(), scale, opts, cost);
+    if (!surface)
+    {
+      return std::nullopt;
+    }
     // end render one frame
     std::optional<std::vector<char>> img;
     {
       layer::ScopedTimer t([&](auto d) { cost.encode = d.s(); });
-      img = layer::exporter::makeImage(opts, surface.get());
+      if (opts.profile == layer::EEncodeProfile::SMALLEST)
+      {
+        auto snapshot = layer::exporter::makeSnapshot(opts, surface);
+        img = snapshot ? encodeFrame(opts, snapshot.get()) : std::nullopt;
+      }
+      else
+      {
+        img = layer::exporter::makeImage(opts, surface);
+      }
     }
     return img;
   }
+
+  // Like render, but stops at a cpu backed snapshot which can be encoded on another thread.
+  sk_sp<SkImage> renderSnapshot(
+    layer::Ref<layer::FrameNode> f,
+    float                        scale,
+    const layer::ImageOptions&   opts,
+    IteratorResult::TimeCost&    cost)
+  {
+    auto surface = draw(f.get(), scale, opts, cost);
+    if (!surface)
+    {
+      return nullptr;
+    }
+    layer::ScopedTimer t([&](auto d) { cost.encode = d.s(); }); // readback on the gpu backend
+    return layer::exporter::makeSnapshot(opts, surface);
+  }
 };
 
 void setGlobalConfig(const std::string& fileName)
@@ -216,8 +610,8 @@ void setGlobalConfig(const std::string& fileName)
   Config::readGlobalConfig(fileName);
 }
 
-Exporter::Exporter()
-  : d_impl(new Exporter__pImpl(this))
+Exporter::Exporter(EBackend backend)
+  : d_impl(new Exporter__pImpl(this, backend))
 {
 }
 
@@ -225,7 +619,16 @@ void Exporter::info(ExporterInfo* info)
 {
   if (info)
   {
-    info->graphicsInfo = d_impl->ctx->vulkanInfo();
+    if (d_impl->backend == EBackend::CPU)
+    {
+      info->graphicsInfo = "cpu raster, " + std::to_string(d_impl->threadCount) + " threads";
+    }
+#ifdef VGG_USE_VULKAN
+    else
+    {
+      info->graphicsInfo = d_impl->ctx->vulkanInfo();
+    }
+#endif
 #ifdef GIT_COMMIT
     info->buildCommit = GIT_COMMIT;
 #else
@@ -236,6 +639,30 @@ void Exporter::info(ExporterInfo* info)
 
 Exporter::~Exporter() = default;
 
+void Exporter::resetDocumentState()
+{
+  layer::purgeDocumentCaches();
+  d_impl->trimSurfaces();
+}
+
+void Exporter::setMemoryLimit(std::size_t bytes)
+{
+  d_impl->memoryLimit = bytes;
+  if (bytes > 0)
+  {
+    // half for the decoded images and masks cached by skia, half for the pooled surfaces
+    SkGraphics::SetResourceCacheTotalByteLimit(bytes / 2);
+#ifdef VGG_USE_VULKAN
+    if (auto dc = d_impl->grRecordingContext ? d_impl->grRecordingContext->asDirectContext()
+                                             : nullptr)
+    {
+      dc->setResourceCacheLimit(bytes / 2);
+    }
+#endif
+  }
+  d_impl->trimSurfaces();
+}
+
 void Exporter::setOutputCallback(OutputCallback callback)
 {
   d_impl->outputCallback = std::move(callback);
@@ -249,55 +676,93 @@ public:
   std::vector<layer::FramePtr>           frames; // FIXME:: use const
   std::vector<layer::FramePtr>::iterator iter;
 
+  // The scenes of the frames are built one by one on first use, see current()
+  std::shared_ptr<Domain::DesignDocument> doc;
+  std::vector<Domain::Element*>           elements; // element of each item of frames
+
   void initInternal(
     nlohmann::json      json,
     nlohmann::json      layout,
     const ExportOption& exportOpt,
     BuilderResult&      result)
   {
+    // checked up front, the scenes are only built as the iterator reaches their frames
+    const std::string version = json.is_object() ? json.value("version", "") : "";
+    if (version != VGG_PARSE_FORMAT_VER_STR)
+    {
+      WARN(
+        "Exporter: the document version %s is not the required version %s",
+        version.c_str(),
+        VGG_PARSE_FORMAT_VER_STR);
+      result.type = BuilderResult::VERSION_MISMATCH;
+    }
+
+    const std::unordered_set<std::string> frameIds(
+      exportOpt.frameIds.begin(),
+      exportOpt.frameIds.end());
     auto res = VGG::entry::DocBuilder::builder()
                  .setDocument(std::move(json))
                  .setLayout(std::move(layout))
                  .setExpandEnabled(exportOpt.enableExpand)
                  .setLayoutEnabled(exportOpt.enableLayout)
+                 .setFrameFilter(frameIds)
                  .build();
     BuilderResult::TimeCost cost;
     cost.layout = res.timeCost.layout.s();
     cost.expand = res.timeCost.expand.s();
 
-    std::vector<layer::StructFrameObject> frames;
-    for (auto& f : *res.doc)
+    doc = std::move(res.doc);
+    if (doc)
     {
-      if (f->type() == VGG::Domain::Element::EType::FRAME)
+      for (auto& f : *doc)
       {
-        frames.emplace_back(layer::StructFrameObject(f.get()));
+        // frames only kept for the masters they hold are not exported
+        if (
+          f->type() == VGG::Domain::Element::EType::FRAME &&
+          (frameIds.empty() || frameIds.contains(f->id())))
+        {
+          elements.push_back(f.get());
+        }
       }
     }
-    auto sceneBuilderResult = VGG::layer::SceneBuilder::builder()
-                                .setResetOriginEnable(true)
-                                .setCheckVersion(VGG_PARSE_FORMAT_VER_STR)
-                                .setAllocator(layer::getGlobalMemoryAllocator())
-                                .build<layer::StructModelFrame>(std::move(frames));
-    if (sceneBuilderResult.type)
+    frames.resize(elements.size());
+    iter = frames.begin();
+    result.timeCost = cost;
+    index = 0;
+  }
+
+  // The frame at iter, its scene is built here on first use. Frames that are invisible or fail
+  // to build are dropped, null at the end.
+  layer::FramePtr current()
+  {
+    if (iter != frames.begin())
     {
-      if (*sceneBuilderResult.type == VGG::layer::SceneBuilderResult::EResultType::VERSION_MISMATCH)
-      {
-        result.type = BuilderResult::VERSION_MISMATCH;
-      }
+      std::prev(iter)->reset(); // iterators only go forward, release the exported scenes
     }
-    if (sceneBuilderResult.root)
+    while (iter != frames.end())
     {
-      for (auto& f : *sceneBuilderResult.root)
+      const auto i = iter - frames.begin();
+      if (!*iter)
       {
-        if (f->isVisible())
+        std::vector<layer::StructFrameObject> objects;
+        objects.emplace_back(layer::StructFrameObject(elements[i]));
+        auto sceneBuilderResult = VGG::layer::SceneBuilder::builder()
+                                    .setResetOriginEnable(true)
+                                    .setAllocator(layer::getGlobalMemoryAllocator())
+                                    .build<layer::StructModelFrame>(std::move(objects));
+        if (sceneBuilderResult.root && !sceneBuilderResult.root->empty())
         {
-          this->frames.push_back(std::move(f));
+          *iter = std::move(sceneBuilderResult.root->front());
         }
       }
-      iter = this->frames.begin();
+      if (*iter && (*iter)->isVisible())
+      {
+        return *iter;
+      }
+      elements.erase(elements.begin() + i);
+      iter = frames.erase(iter);
     }
-    result.timeCost = cost;
-    index = 0;
+    return nullptr;
   }
 
   IteratorImplBase(
@@ -316,63 +781,76 @@ class ImageIteratorImpl : public IteratorImplBase
 public:
   Exporter&               exporter;
   ImageOption::SizePolicy size;
+  int                     maxFramesInFlight{ 0 };
+  EPixelFormat            pixelFormat{ EPixelFormat::RGBA_8888 };
+  bool                    premultiplied{ false };
+  EEncodeProfile          encodeProfile{ EEncodeProfile::DEFAULT };
+  std::vector<char>       pixelBuffer; // pooled destination of nextPixels
+
+  // A frame rendered and being encoded in the background, see nextPipelined
+  struct PendingFrame
+  {
+    struct Encoded
+    {
+      std::optional<std::vector<char>> image;
+      float                            encode{ 0.f };
+    };
+    std::string              key;
+    IteratorResult::TimeCost cost;
+    std::future<Encoded>     result;
+  };
+  std::deque<PendingFrame> pending;
+  bool                     renderFailed{ false };
+
   ImageIteratorImpl(
-    Exporter&               exporter,
-    nlohmann::json          json,
-    nlohmann::json          layout,
-    ImageOption::SizePolicy size,
-    const ExportOption&     opt,
-    BuilderResult&          result)
+    Exporter&           exporter,
+    nlohmann::json      json,
+    nlohmann::json      layout,
+    const ImageOption&  imageOpt,
+    const ExportOption& opt,
+    BuilderResult&      result)
     : IteratorImplBase(std::move(json), std::move(layout), opt, result)
     , exporter(exporter)
-    , size(size)
+    , size(imageOpt.size)
+    , maxFramesInFlight(std::max(0, imageOpt.maxFramesInFlight))
+    , pixelFormat(imageOpt.pixelFormat)
+    , premultiplied(imageOpt.premultiplied)
+    , encodeProfile(imageOpt.encodeProfile)
   {
-    exporter.d_impl->resize(MAX_WIDTH, MAX_HEIGHT);
   }
 
-  bool next(
-    std::string&              key,
-    std::vector<char>&        image,
-    EImageType                type,
-    int                       quality,
-    IteratorResult::TimeCost& cost)
+  // Scale of a w x h frame; clampToSurface limits the output to the max surface size.
+  float resolveScale(
+    const ImageOption::SizePolicy& policy,
+    float                          w,
+    float                          h,
+    bool                           clampToSurface,
+    float                          actualSize[2])
   {
-    if (iter == frames.end())
-    {
-      return false;
-    }
-    auto f = *iter;
-    if (!f)
-      return false;
-    f->revalidate();
-    const auto b = f->bounds();
-    const auto id = f->guid();
-    const auto w = b.size().x;
-    const auto h = b.size().y;
-
-    auto          state = exporter.d_impl.get();
-    float         actualSize[2];
     float         scale = 1.0;
     constexpr int MAX_SIDE = std::min(MAX_WIDTH, MAX_HEIGHT);
+    const float   maxWidth = clampToSurface ? MAX_WIDTH : std::numeric_limits<float>::max();
+    const float   maxHeight = clampToSurface ? MAX_HEIGHT : std::numeric_limits<float>::max();
+    const float   maxSide = clampToSurface ? MAX_SIDE : std::numeric_limits<float>::max();
     std::visit(
       layer::Overloaded{ [&](const ImageOption::ScaleDetermine& s)
                          {
-                           auto maxScale = MAX_SIDE / std::max(w, h);
+                           auto maxScale = maxSide / std::max(w, h);
                            scale = s.value > maxScale ? maxScale : s.value;
                            actualSize[0] = scale * w;
                            actualSize[1] = scale * h;
                          },
                          [&](const ImageOption::WidthDetermine& width)
                          {
-                           auto maxSide = width.value > MAX_SIDE ? MAX_SIDE : width.value;
-                           scale = std::min({ MAX_HEIGHT / w, MAX_WIDTH / h, maxSide / w });
+                           auto side = std::min(width.value, maxSide);
+                           scale = std::min({ maxHeight / w, maxWidth / h, side / w });
                            actualSize[0] = scale * w;
                            actualSize[1] = scale * h;
                          },
                          [&](const ImageOption::HeightDetermine& height)
                          {
-                           auto maxSide = height.value > MAX_SIDE ? MAX_SIDE : height.value;
-                           scale = std::min({ MAX_HEIGHT / w, MAX_WIDTH / h, maxSide / h });
+                           auto side = std::min(height.value, maxSide);
+                           scale = std::min({ maxHeight / w, maxWidth / h, side / h });
                            actualSize[0] = scale * w;
                            actualSize[1] = scale * h;
                          },
@@ -387,7 +865,23 @@ public:
                              actualSize[0],
                              actualSize[1]);
                          } },
-      size);
+      policy);
+    return scale;
+  }
+
+  layer::ImageOptions imageOptions(
+    layer::FrameNode*              f,
+    const ImageOption::SizePolicy& policy,
+    EImageType                     type,
+    int                            quality,
+    float&                         scale)
+  {
+    const auto b = f->bounds();
+    const auto w = b.size().x;
+    const auto h = b.size().y;
+
+    float actualSize[2];
+    scale = resolveScale(policy, w, h, true, actualSize);
     layer::ImageOptions opts;
     opts.encode = toEImageEncode(type);
     opts.position[0] = 0;
@@ -402,13 +896,277 @@ public:
       opts.extend[1],
       actualSize[1]);
     opts.quality = quality;
-    auto res = state->render(f, scale, opts, cost);
+    opts.pixelFormat = toEPixelFormat(pixelFormat);
+    opts.premultiplied = premultiplied;
+    opts.profile = toEEncodeProfile(encodeProfile);
+    return opts;
+  }
+
+  bool next(
+    std::string&              key,
+    std::vector<char>&        image,
+    EImageType                type,
+    int                       quality,
+    IteratorResult::TimeCost& cost)
+  {
+    if (maxFramesInFlight > 0)
+    {
+      return nextPipelined(key, image, type, quality, cost);
+    }
+    if (iter == frames.end())
+    {
+      return false;
+    }
+    auto f = current();
+    if (!f)
+      return false;
+    f->revalidate();
+    const auto id = f->guid();
+
+    float scale;
+    auto  opts = imageOptions(f.get(), size, type, quality, scale);
+    auto  res = exporter.d_impl->render(f, scale, opts, cost);
     if (!res.has_value())
     {
       return false;
     }
     key = std::move(id);
     image = std::move(res.value());
+    cost.bytes = image.size();
+    ++iter;
+    return true;
+  }
+
+  // Renders the next frame and hands its snapshot to a worker for encoding.
+  bool schedule(EImageType type, int quality)
+  {
+    auto f = current();
+    if (!f)
+      return false;
+    f->revalidate();
+
+    PendingFrame frame;
+    float        scale;
+    auto         opts = imageOptions(f.get(), size, type, quality, scale);
+    auto         snapshot = exporter.d_impl->renderSnapshot(f, scale, opts, frame.cost);
+    if (!snapshot)
+    {
+      return false;
+    }
+    frame.key = f->guid();
+    frame.result = std::async(
+      std::launch::async,
+      [opts, snapshot = std::move(snapshot)]()
+      {
+        PendingFrame::Encoded res;
+        layer::ScopedTimer    t([&](auto d) { res.encode = d.s(); });
+        res.image = encodeFrame(opts, snapshot.get());
+        return res;
+      });
+    pending.push_back(std::move(frame));
+    ++iter;
+    return true;
+  }
+
+  // Frame N + 1 renders while frame N is encoded on a worker, at most maxFramesInFlight frames
+  // are rendered ahead, which bounds the snapshots held in memory. Results keep the frame order.
+  bool nextPipelined(
+    std::string&              key,
+    std::vector<char>&        image,
+    EImageType                type,
+    int                       quality,
+    IteratorResult::TimeCost& cost)
+  {
+    while (!renderFailed && iter != frames.end() &&
+           pending.size() < static_cast<std::size_t>(maxFramesInFlight))
+    {
+      renderFailed = !schedule(type, quality);
+    }
+    if (pending.empty())
+    {
+      return false;
+    }
+
+    auto frame = std::move(pending.front());
+    pending.pop_front();
+    auto encoded = frame.result.get();
+    cost = frame.cost;
+    cost.encode += encoded.encode;
+    if (!encoded.image)
+    {
+      return false;
+    }
+    key = std::move(frame.key);
+    image = std::move(*encoded.image);
+    cost.bytes = image.size();
+    return true;
+  }
+
+  bool nextPixels(
+    std::string&              key,
+    const PixelAllocator&     allocate,
+    int                       quality,
+    IteratorResult::TimeCost& cost)
+  {
+    key.clear();
+    if (iter == frames.end())
+    {
+      return false;
+    }
+    auto f = current();
+    if (!f)
+      return false;
+    // a frame that fails is skipped with its key set, the end leaves the key empty
+    key = f->guid();
+    ++iter;
+    f->revalidate();
+
+    float scale;
+    auto  opts = imageOptions(f.get(), size, RAW, quality, scale);
+    auto  surface = exporter.d_impl->draw(f.get(), scale, opts, cost);
+    if (!surface)
+    {
+      WARN("Exporter: failed to draw frame %s", key.c_str());
+      return false;
+    }
+    layer::ScopedTimer t([&](auto d) { cost.encode = d.s(); });
+    std::size_t        rowBytes = layer::exporter::rawImageInfo(opts).minRowBytes();
+    auto               dst = allocate(opts.extend[0], opts.extend[1], rowBytes);
+    if (!dst || !layer::exporter::readPixels(opts, surface, dst, rowBytes))
+    {
+      WARN("Exporter: failed to read the pixels of frame %s", key.c_str());
+      return false;
+    }
+    return true;
+  }
+
+  // The frame is traversed once into a picture, the variants play it back on their own raster
+  // surfaces. The images in the picture are decoded once and shared by the variants.
+  bool nextVariants(
+    std::string&                             key,
+    const std::vector<ImageOption::Variant>& variants,
+    std::vector<std::vector<char>>&          images)
+  {
+    if (iter == frames.end())
+    {
+      return false;
+    }
+    auto f = current();
+    if (!f)
+      return false;
+    f->revalidate();
+    const auto b = f->bounds();
+    auto       picture = Exporter__pImpl::recordFrame(
+      f.get(),
+      1.f,
+      std::ceil(b.size().x),
+      std::ceil(b.size().y));
+
+    std::vector<std::pair<layer::ImageOptions, float>> variantOptions;
+    for (const auto& variant : variants)
+    {
+      float scale;
+      auto  opts = imageOptions(f.get(), variant.size, variant.type, variant.imageQuality, scale);
+      variantOptions.emplace_back(opts, scale);
+    }
+
+    // at most threadCount variants, and so raster surfaces, at a time
+    std::vector<std::optional<std::vector<char>>> results(variants.size());
+    std::atomic<std::size_t>                      nextVariant{ 0 };
+    auto                                          exportVariants = [&]()
+    {
+      for (auto i = nextVariant++; i < variants.size(); i = nextVariant++)
+      {
+        const auto& [opts, scale] = variantOptions[i];
+        auto surface =
+          SkSurfaces::Raster(SkImageInfo::MakeN32Premul(opts.extend[0], opts.extend[1]));
+        if (!surface)
+        {
+          continue;
+        }
+        auto canvas = surface->getCanvas();
+        canvas->clear(SK_ColorWHITE);
+        canvas->scale(scale, scale);
+        canvas->drawPicture(picture);
+        auto snapshot = layer::exporter::makeSnapshot(opts, surface.get());
+        results[i] = snapshot ? encodeFrame(opts, snapshot.get()) : std::nullopt;
+      }
+    };
+    const auto workerCount =
+      std::min<std::size_t>(exporter.d_impl->threadCount, variants.size());
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < workerCount; ++i)
+    {
+      workers.emplace_back(exportVariants);
+    }
+    exportVariants(); // this thread is one of them
+    for (auto& worker : workers)
+    {
+      worker.join();
+    }
+
+    images.clear();
+    for (auto& image : results)
+    {
+      if (!image)
+      {
+        WARN("Exporter: failed to export a variant of %s", f->guid().c_str());
+      }
+      images.push_back(image ? std::move(*image) : std::vector<char>{});
+    }
+    key = f->guid();
+    ++iter;
+    return true;
+  }
+
+  bool next(
+    std::string&              key,
+    const StreamCallback&     callback,
+    EImageType                type,
+    int                       quality,
+    IteratorResult::TimeCost& cost)
+  {
+    if (type != PNG && type != RAW)
+    {
+      // no row encoder for the lossy formats, the frame is encoded from the surface
+      std::vector<char> image;
+      return next(key, image, type, quality, cost) && callback(image.data(), image.size());
+    }
+
+    if (iter == frames.end())
+    {
+      return false;
+    }
+    auto f = current();
+    if (!f)
+      return false;
+    f->revalidate();
+    const auto b = f->bounds();
+    const auto w = b.size().x;
+    const auto h = b.size().y;
+
+    float      actualSize[2];
+    float      scale = resolveScale(size, w, h, false, actualSize);
+    const auto width = std::max(1l, std::lroundf(actualSize[0]));
+    const auto height = std::max(1l, std::lroundf(actualSize[1]));
+    if (width > std::numeric_limits<int>::max() / 4 || height > std::numeric_limits<int>::max())
+    {
+      WARN("Exporter: output size %ld x %ld is too large", width, height);
+      return false;
+    }
+
+    auto encoder = makeRowEncoder(type, width, height, quality, encodeProfile, callback);
+    ASSERT(encoder);
+
+    layer::ScopedTimer t([&](auto d) { cost.render = d.s(); }); // render and encode overlap
+    const auto colorType = type == RAW && pixelFormat == EPixelFormat::BGRA_8888
+                             ? kBGRA_8888_SkColorType
+                             : kRGBA_8888_SkColorType;
+    if (!exporter.d_impl->renderStreamed(f.get(), scale, width, height, colorType, *encoder))
+    {
+      return false;
+    }
+    key = f->guid();
     ++iter;
     return true;
   }
@@ -421,6 +1179,38 @@ bool ImageIterator::next(std::string& key, std::vector<char>& image)
   return d_impl->next(key, image, m_opts.type, m_opts.imageQuality, cost);
 }
 
+bool ImageIterator::next(std::string& key, const StreamCallback& callback)
+{
+  IteratorResult::TimeCost cost;
+  return d_impl->next(key, callback, m_opts.type, m_opts.imageQuality, cost);
+}
+
+bool ImageIterator::nextPixels(std::string& key, const PixelAllocator& allocate)
+{
+  IteratorResult::TimeCost cost;
+  return d_impl->nextPixels(key, allocate, m_opts.imageQuality, cost);
+}
+
+bool ImageIterator::nextPixels(const PixelCallback& callback)
+{
+  IteratorResult::TimeCost cost;
+  std::string              key;
+  PixelView                view;
+  auto&                    buffer = d_impl->pixelBuffer;
+  auto                     allocate = [&](int w, int h, std::size_t& rowBytes) -> void*
+  {
+    buffer.resize(rowBytes * h); // reuses the capacity of the previous frame
+    view = { buffer.data(), w, h, rowBytes };
+    return buffer.data();
+  };
+  return d_impl->nextPixels(key, allocate, m_opts.imageQuality, cost) && callback(key, view);
+}
+
+bool ImageIterator::nextVariants(std::string& key, std::vector<std::vector<char>>& images)
+{
+  return d_impl->nextVariants(key, m_opts.variants, images);
+}
+
 IteratorResult ImageIterator::next()
 {
   std::string              key;
@@ -449,7 +1239,7 @@ ImageIterator::ImageIterator(
       exporter,
       std::move(design),
       std::move(layout),
-      opt.size,
+      opt,
       exportOpt,
       result))
   , m_opts(opt)
@@ -477,7 +1267,7 @@ bool SVGIterator::next(std::string& key, std::vector<char>& data)
   {
     return false;
   }
-  auto f = *d_impl->iter;
+  auto f = d_impl->current();
   if (!f)
     return false;
   f->revalidate();
@@ -498,6 +1288,30 @@ bool SVGIterator::next(std::string& key, std::vector<char>& data)
   return true;
 }
 
+bool SVGIterator::next(std::string& key, const StreamCallback& callback)
+{
+  if (d_impl->iter == d_impl->frames.end())
+  {
+    return false;
+  }
+  auto f = d_impl->current();
+  if (!f)
+    return false;
+  f->revalidate();
+  auto b = f->bounds();
+
+  layer::exporter::SVGOptions opts;
+  opts.extend[0] = b.width();
+  opts.extend[1] = b.height();
+  if (!layer::exporter::makeSVG(f, opts, callback))
+  {
+    return false;
+  }
+  key = f->guid();
+  ++d_impl->iter;
+  return true;
+}
+
 IteratorResult SVGIterator::next()
 {
   std::string       key;
@@ -534,7 +1348,7 @@ bool PDFIterator::next(std::string& key, std::vector<char>& data)
   {
     return false;
   }
-  auto f = *d_impl->iter;
+  auto f = d_impl->current();
   if (!f)
     return false;
   f->revalidate();
@@ -554,6 +1368,54 @@ bool PDFIterator::next(std::string& key, std::vector<char>& data)
   return true;
 }
 
+bool PDFIterator::next(std::string& key, const StreamCallback& callback)
+{
+  if (d_impl->iter == d_impl->frames.end())
+  {
+    return false;
+  }
+  auto f = d_impl->current();
+  if (!f)
+    return false;
+  f->revalidate();
+  auto                        b = f->bounds();
+  layer::exporter::PDFOptions opts;
+  opts.extend[0] = b.width();
+  opts.extend[1] = b.height();
+  if (!layer::exporter::makePDF(f, opts, callback))
+  {
+    return false;
+  }
+  key = f->guid();
+  ++d_impl->iter;
+  return true;
+}
+
+bool PDFIterator::nextDocument(const StreamCallback& callback)
+{
+  if (d_impl->iter == d_impl->frames.end())
+  {
+    return false;
+  }
+  layer::exporter::PDFDocument doc(callback);
+  for (; d_impl->iter != d_impl->frames.end(); ++d_impl->iter)
+  {
+    auto f = d_impl->current();
+    if (!f)
+      break; // the remaining frames are invisible
+    f->revalidate();
+    auto                        b = f->bounds();
+    layer::exporter::PDFOptions opts;
+    opts.extend[0] = b.width();
+    opts.extend[1] = b.height();
+    if (!doc.addPage(f, opts))
+    {
+      return false;
+    }
+  }
+  return doc.close();
+}
+
 IteratorResult PDFIterator::next()
 {
   std::string       key;
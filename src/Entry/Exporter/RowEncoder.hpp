@@ -0,0 +1,313 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "VGG/Exporter/Type.hpp"
+#include "Utility/Log.hpp"
+
+#include <miniz.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace VGG::exporter
+{
+
+// Encodes an image row by row and hands the output to the callback as it is produced, so the
+// whole image never has to be in memory. Rows are 8888 and opaque, RGBA unless the raw pixel
+// format asks for BGRA.
+class RowEncoder
+{
+public:
+  virtual ~RowEncoder() = default;
+  virtual bool writeRows(const uint8_t* rows, std::size_t rowBytes, int count) = 0;
+  virtual bool finish() = 0;
+};
+
+class RawRowEncoder : public RowEncoder
+{
+  int            m_width;
+  StreamCallback m_callback;
+
+public:
+  RawRowEncoder(int width, StreamCallback callback)
+    : m_width(width)
+    , m_callback(std::move(callback))
+  {
+  }
+
+  bool writeRows(const uint8_t* rows, std::size_t rowBytes, int count) override
+  {
+    for (int i = 0; i < count; ++i)
+    {
+      if (!m_callback(reinterpret_cast<const char*>(rows + i * rowBytes), m_width * 4))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool finish() override
+  {
+    return true;
+  }
+};
+
+// PNG, 8 bit RGB with the "up" filter for every row, the alpha of the opaque rows is dropped; or 8
+// bit indexed color without filtering as recommended for palettes. Deflated with miniz which is
+// bundled with zip.
+class PngRowEncoder : public RowEncoder
+{
+  static constexpr std::size_t IDAT_SIZE = 1 << 16;
+
+  int                               m_width;
+  int                               m_bytesPerPixel; // of the png, rows have 4 for RGB
+  StreamCallback                    m_callback;
+  std::unique_ptr<tdefl_compressor> m_compressor;
+  std::vector<uint8_t>              m_packedRow; // RGB only
+  std::vector<uint8_t>              m_previousRow;
+  std::vector<uint8_t>              m_filteredRow;
+  std::vector<uint8_t>              m_idat;
+  bool                              m_ok{ true };
+
+  PngRowEncoder(
+    int            width,
+    int            height,
+    int            level,
+    uint8_t        colorType,
+    int            bytesPerPixel,
+    StreamCallback callback)
+    : m_width(width)
+    , m_bytesPerPixel(bytesPerPixel)
+    , m_callback(std::move(callback))
+    , m_compressor(std::make_unique<tdefl_compressor>())
+    , m_packedRow(bytesPerPixel == 3 ? width * bytesPerPixel : 0)
+    , m_previousRow(width * bytesPerPixel, 0)
+    , m_filteredRow(width * bytesPerPixel + 1, 0)
+  {
+    tdefl_init(m_compressor.get(), &PngRowEncoder::onDeflated, this, deflateFlags(level));
+    m_idat.reserve(IDAT_SIZE);
+
+    static constexpr uint8_t SIGNATURE[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+    m_ok = m_callback(reinterpret_cast<const char*>(SIGNATURE), sizeof(SIGNATURE));
+
+    uint8_t ihdr[13];
+    putUint32(ihdr, width);
+    putUint32(ihdr + 4, height);
+    ihdr[8] = 8;         // bit depth
+    ihdr[9] = colorType; // 2 for RGB, 3 for indexed
+    ihdr[10] = 0;        // compression
+    ihdr[11] = 0;        // filter
+    ihdr[12] = 0;        // interlace
+    writeChunk("IHDR", ihdr, sizeof(ihdr));
+  }
+
+public:
+  PngRowEncoder(
+    int            width,
+    int            height,
+    int            quality,
+    EEncodeProfile profile,
+    StreamCallback callback)
+    : PngRowEncoder(width, height, zlibLevel(quality, profile), 2, 3, std::move(callback))
+  {
+  }
+
+  // Rows are one index into the palette per pixel, the palette holds up to 256 0xRRGGBB colors.
+  static std::unique_ptr<PngRowEncoder> makeIndexed(
+    int                          width,
+    int                          height,
+    int                          level,
+    const std::vector<uint32_t>& palette,
+    StreamCallback               callback)
+  {
+    ASSERT(!palette.empty() && palette.size() <= 256);
+    std::unique_ptr<PngRowEncoder> encoder(
+      new PngRowEncoder(width, height, level, 3, 1, std::move(callback)));
+    std::vector<uint8_t> plte;
+    plte.reserve(palette.size() * 3);
+    for (auto c : palette)
+    {
+      plte.push_back(uint8_t(c >> 16));
+      plte.push_back(uint8_t(c >> 8));
+      plte.push_back(uint8_t(c));
+    }
+    encoder->writeChunk("PLTE", plte.data(), plte.size());
+    return encoder;
+  }
+
+  // same level mapping as layer::exporter::encodeImage
+  static int zlibLevel(int quality, EEncodeProfile profile = EEncodeProfile::DEFAULT)
+  {
+    switch (profile)
+    {
+      case EEncodeProfile::FAST:
+        return 1;
+      case EEncodeProfile::BALANCED:
+        return 6;
+      case EEncodeProfile::SMALLEST:
+        return 9;
+      default:
+        quality = std::max(std::min(quality, 100), 0);
+        return std::max(std::min(9, (100 - quality) / 10), 0);
+    }
+  }
+
+  bool writeRows(const uint8_t* rows, std::size_t rowBytes, int count) override
+  {
+    const std::size_t n = m_width * m_bytesPerPixel;
+    const bool        up = m_bytesPerPixel > 1;
+    for (int i = 0; i < count && m_ok; ++i)
+    {
+      const uint8_t* row = rows + i * rowBytes;
+      if (!m_packedRow.empty())
+      {
+        for (int x = 0; x < m_width; ++x)
+        {
+          std::memcpy(&m_packedRow[x * 3], row + x * 4, 3);
+        }
+        row = m_packedRow.data();
+      }
+
+      m_filteredRow[0] = up ? 2 : 0; // up or none
+      for (std::size_t x = 0; x < n; ++x)
+      {
+        m_filteredRow[x + 1] = up ? uint8_t(row[x] - m_previousRow[x]) : row[x];
+      }
+      if (up)
+      {
+        std::memcpy(m_previousRow.data(), row, n);
+      }
+
+      if (
+        tdefl_compress_buffer(
+          m_compressor.get(),
+          m_filteredRow.data(),
+          m_filteredRow.size(),
+          TDEFL_NO_FLUSH) != TDEFL_STATUS_OKAY)
+      {
+        m_ok = false;
+      }
+    }
+    return m_ok;
+  }
+
+  bool finish() override
+  {
+    if (
+      m_ok &&
+      tdefl_compress_buffer(m_compressor.get(), nullptr, 0, TDEFL_FINISH) != TDEFL_STATUS_DONE)
+    {
+      m_ok = false;
+    }
+    flushIdat();
+    writeChunk("IEND", nullptr, 0);
+    return m_ok;
+  }
+
+private:
+  static mz_uint deflateFlags(int level)
+  {
+    // tdefl_create_comp_flags_from_zip_params is only declared with the zlib apis of miniz
+    static constexpr mz_uint NUM_PROBES[] = { 0, 1, 6, 32, 16, 32, 128, 256, 512, 768, 1500 };
+    mz_uint flags = TDEFL_WRITE_ZLIB_HEADER | NUM_PROBES[level];
+    if (level <= 3)
+    {
+      flags |= TDEFL_GREEDY_PARSING_FLAG;
+    }
+    if (level == 0)
+    {
+      flags |= TDEFL_FORCE_ALL_RAW_BLOCKS;
+    }
+    return flags;
+  }
+
+  static mz_bool onDeflated(const void* data, int size, void* user)
+  {
+    auto self = static_cast<PngRowEncoder*>(user);
+    auto bytes = static_cast<const uint8_t*>(data);
+    self->m_idat.insert(self->m_idat.end(), bytes, bytes + size);
+    if (self->m_idat.size() >= IDAT_SIZE)
+    {
+      self->flushIdat();
+    }
+    return self->m_ok ? MZ_TRUE : MZ_FALSE;
+  }
+
+  void flushIdat()
+  {
+    if (!m_idat.empty())
+    {
+      writeChunk("IDAT", m_idat.data(), m_idat.size());
+      m_idat.clear();
+    }
+  }
+
+  void writeChunk(const char* type, const uint8_t* data, std::size_t size)
+  {
+    if (!m_ok)
+    {
+      return;
+    }
+
+    uint8_t header[8];
+    putUint32(header, uint32_t(size));
+    std::memcpy(header + 4, type, 4);
+    auto crc = mz_crc32(MZ_CRC32_INIT, header + 4, 4);
+    if (size > 0)
+    {
+      crc = mz_crc32(crc, data, size);
+    }
+    uint8_t footer[4];
+    putUint32(footer, uint32_t(crc));
+
+    m_ok = m_callback(reinterpret_cast<const char*>(header), sizeof(header)) &&
+           (size == 0 || m_callback(reinterpret_cast<const char*>(data), size)) &&
+           m_callback(reinterpret_cast<const char*>(footer), sizeof(footer));
+  }
+
+  static void putUint32(uint8_t* p, uint32_t v)
+  {
+    p[0] = uint8_t(v >> 24);
+    p[1] = uint8_t(v >> 16);
+    p[2] = uint8_t(v >> 8);
+    p[3] = uint8_t(v);
+  }
+};
+
+inline std::unique_ptr<RowEncoder> makeRowEncoder(
+  EImageType     type,
+  int            width,
+  int            height,
+  int            quality,
+  EEncodeProfile profile,
+  StreamCallback callback)
+{
+  switch (type)
+  {
+    case PNG:
+      return std::make_unique<PngRowEncoder>(width, height, quality, profile, std::move(callback));
+    case RAW:
+      return std::make_unique<RawRowEncoder>(width, std::move(callback));
+    default:
+      return nullptr;
+  }
+}
+
+} // namespace VGG::exporter
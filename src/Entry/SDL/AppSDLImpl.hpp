@@ -29,7 +29,11 @@
 #include <SDL_opengl.h>
 #include <SDL_video.h>
 
+#include <algorithm>
 #include <any>
+#include <chrono>
+#include <climits>
+#include <cstdint>
 #include <optional>
 
 namespace VGG::entry
@@ -257,17 +261,48 @@ public:
   void pollEvent()
   {
     SDL_Event evt;
-#ifdef EMSCRIPTEN
     while (SDL_PollEvent(&evt))
-#else
-    while (SDL_WaitEventTimeout(&evt, 1))
-#endif
     {
-      auto event = toUEvent(evt, resolutionScale());
-      sendEvent(event);
+      handleEvent(evt);
+    }
+  }
+
+  // Sleeps until an event comes or `deadline` passes, without a deadline until an event comes,
+  // then handles the pending events. wakeUp ends the wait from any thread.
+  void waitEvent(std::optional<std::chrono::steady_clock::time_point> deadline)
+  {
+    using namespace std::chrono;
+
+    SDL_Event evt;
+    int       hasEvent = 0;
+    if (!deadline)
+    {
+      hasEvent = SDL_WaitEvent(&evt);
+    }
+    else if (const auto timeout = ceil<milliseconds>(*deadline - steady_clock::now()).count();
+             timeout > 0)
+    {
+      hasEvent = SDL_WaitEventTimeout(&evt, static_cast<int>(std::min<int64_t>(timeout, INT_MAX)));
+    }
+    else
+    {
+      hasEvent = SDL_PollEvent(&evt);
+    }
+
+    if (hasEvent)
+    {
+      handleEvent(evt);
+      pollEvent();
     }
   }
 
+  static void wakeUp()
+  {
+    SDL_Event evt{};
+    evt.type = wakeUpEventType();
+    SDL_PushEvent(&evt);
+  }
+
   void swapBuffer()
   {
     // auto profiler = CappingProfiler::getInstance();
@@ -287,6 +322,23 @@ public:
     return &m_glContext;
   }
 
+private:
+  static Uint32 wakeUpEventType()
+  {
+    static const Uint32 s_type = SDL_RegisterEvents(1);
+    return s_type;
+  }
+
+  void handleEvent(const SDL_Event& evt)
+  {
+    if (evt.type == wakeUpEventType())
+    {
+      return;
+    }
+    sendEvent(toUEvent(evt, resolutionScale()));
+  }
+
+public:
   ~AppSDLImpl()
   {
   }
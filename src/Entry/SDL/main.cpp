@@ -119,12 +119,16 @@ int main(int argc, char** argv)
   controller->start(darumaFileOrDir, "../asset/vgg-format.json", "../asset/vgg_layout.json");
   app->setController(controller);
 
+  // sleep until an event comes, a frame is due or the run loop has work, which may be queued by
+  // the js thread
+  mainComposer.runLoop()->setWakeUpHandler([](const RunLoop::TimePoint&) { AppImpl::wakeUp(); });
   while (!sdlApp->shouldExit())
   {
-    sdlApp->poll();
+    sdlApp->waitEvent(app->nextWakeUp());
     app->paint(cfg.renderFPSLimit);
-    mainComposer.runLoop()->dispatch();
+    mainComposer.runLoop()->dispatch(app->frameBudget());
   }
+  mainComposer.runLoop()->setWakeUpHandler({});
 
   VGG::Environment::tearDown();
   return 0;
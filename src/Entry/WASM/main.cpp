@@ -28,6 +28,7 @@
 #include <emscripten/emscripten.h>
 #endif
 
+#include <chrono>
 #include <memory>
 
 using AppImpl = VGG::entry::AppSDLImpl;
@@ -47,10 +48,18 @@ void vggEmscriptenFrame()
 
   s_sdlApp->poll();
 
+  // called on every animation frame of the browser, which can not be slept through: poll handled
+  // the events, skip paint and the run loop until they have work due
+  const auto wakeUp = application()->nextWakeUp();
+  if (!wakeUp || *wakeUp > std::chrono::steady_clock::now())
+  {
+    return;
+  }
+
   application()->paint(s_sdlApp->appConfig().renderFPSLimit);
 
   auto& mainComposer = VggBrowser::mainComposer();
-  mainComposer.runLoop()->dispatch();
+  mainComposer.runLoop()->dispatch(application()->frameBudget());
 }
 
 class VggWasm
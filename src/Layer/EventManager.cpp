@@ -1,24 +1,102 @@
 #include "Layer/Core/EventManager.hpp"
 #include "Layer/Core/RenderNode.hpp"
 
+#include <algorithm>
+
 namespace VGG::layer
 {
 
+void EventManager::postEvent(Event e)
+{
+  auto node = e.node.lock();
+  if (!node || node->m_queued.exchange(true, std::memory_order_acq_rel))
+  {
+    return;
+  }
+
+  auto&                       self = sharedInstance();
+  std::lock_guard<std::mutex> lock(self.m_mutex);
+  self.m_eventQueue.push_back(std::move(e));
+  self.m_hasEvents.store(true, std::memory_order_release);
+}
+
+std::size_t EventManager::pendingEvents()
+{
+  auto&                       self = sharedInstance();
+  std::lock_guard<std::mutex> lock(self.m_mutex);
+  return self.m_eventQueue.size();
+}
+
+int EventManager::depth(VNode* node, std::unordered_map<VNode*, int>& cache)
+{
+  if (auto it = cache.find(node); it != cache.end())
+  {
+    return it->second;
+  }
+
+  cache[node] = 0; // guard against observer cycles
+  int d = 0;
+  for (auto& obs : node->m_observers)
+  {
+    if (auto p = obs.lock())
+    {
+      d = std::max(d, depth(p.get(), cache) + 1);
+    }
+  }
+  cache[node] = d;
+  return d;
+}
+
 void EventManager::pollEvents()
 {
-  while (!sharedInstance().m_eventQueue.empty())
+  auto&                           self = sharedInstance();
+  std::vector<Event>              events;
+  std::vector<Ref<VNode>>         nodes;
+  std::unordered_map<VNode*, int> depthCache;
+  while (true)
   {
-    auto e = sharedInstance().m_eventQueue.front();
-    sharedInstance().m_eventQueue.pop();
-    switch (e.event)
     {
-      case ENodeEvent::UPDATE:
-        if (auto p = e.node.lock())
-        {
-          p->invalidate();
-          p->m_state &= ~VNode::EState::UPDATE;
-        }
-        break;
+      std::lock_guard<std::mutex> lock(self.m_mutex);
+      if (self.m_eventQueue.empty())
+      {
+        self.m_hasEvents.store(false, std::memory_order_release);
+        return;
+      }
+      events.swap(self.m_eventQueue);
+    }
+
+    nodes.clear();
+    for (auto& e : events)
+    {
+      switch (e.event)
+      {
+        case ENodeEvent::UPDATE:
+          if (auto p = e.node.lock())
+          {
+            nodes.push_back(std::move(p));
+          }
+          break;
+      }
+    }
+    events.clear();
+
+    // Invalidate the observers first, invalidation bubbling from the observed nodes then stops at
+    // an already invalid ancestor instead of walking up the whole chain again.
+    depthCache.clear();
+    for (auto& p : nodes)
+    {
+      depth(p.get(), depthCache);
+    }
+    std::stable_sort(
+      nodes.begin(),
+      nodes.end(),
+      [&](const auto& a, const auto& b) { return depthCache[a.get()] < depthCache[b.get()]; });
+
+    for (auto& p : nodes)
+    {
+      // clear the flag first so that the node can be queued again during invalidation
+      p->m_queued.store(false, std::memory_order_release);
+      p->invalidate();
     }
   }
 }
@@ -31,6 +31,7 @@
 #include <encode/SkJpegEncoder.h>
 #include <encode/SkWebpEncoder.h>
 #include <gpu/GrDirectContext.h>
+#include <core/SkBitmap.h>
 
 #include <optional>
 #include <vector>
@@ -38,6 +39,7 @@
 #include <sstream>
 #include <fstream>
 #include <iterator>
+#include <unordered_set>
 
 static void renderInternal(SkCanvas* canvas, VGG::layer::FrameNode* frame)
 {
@@ -55,38 +57,160 @@ static void renderInternal(SkCanvas* canvas, VGG::layer::FrameNode* frame)
 namespace VGG::layer::exporter
 {
 
+ColorStats analyzeColors(const SkPixmap& pixmap, std::vector<uint32_t>* palette)
+{
+  ColorStats stats;
+  const auto ct = pixmap.colorType();
+  if (ct != kRGBA_8888_SkColorType && ct != kBGRA_8888_SkColorType)
+  {
+    return { false, false, MAX_PALETTE_COLORS + 1 };
+  }
+  const bool                   bgra = ct == kBGRA_8888_SkColorType;
+  std::unordered_set<uint32_t> colors;
+  uint32_t                     last = 0;
+  bool                         first = true;
+  for (int y = 0; y < pixmap.height(); ++y)
+  {
+    auto p = static_cast<const uint8_t*>(pixmap.addr(0, y));
+    for (int x = 0; x < pixmap.width(); ++x, p += 4)
+    {
+      const uint32_t r = bgra ? p[2] : p[0];
+      const uint32_t g = p[1];
+      const uint32_t b = bgra ? p[0] : p[2];
+      stats.opaque = stats.opaque && p[3] == 0xff;
+      stats.gray = stats.gray && r == g && g == b;
+      const uint32_t c = (r << 16) | (g << 8) | b;
+      if ((first || c != last) && colors.size() <= MAX_PALETTE_COLORS) // flat art repeats a lot
+      {
+        colors.insert(c);
+      }
+      first = false;
+      last = c;
+    }
+    if (!stats.opaque && !stats.gray && colors.size() > MAX_PALETTE_COLORS)
+    {
+      break; // nothing left to find out
+    }
+  }
+  stats.colorCount = colors.size();
+  if (palette && stats.colorCount <= MAX_PALETTE_COLORS)
+  {
+    palette->assign(colors.begin(), colors.end());
+  }
+  return stats;
+}
+
+namespace
+{
+std::optional<std::vector<char>> toVector(sk_sp<SkData> data)
+{
+  if (!data)
+  {
+    return std::nullopt;
+  }
+  return std::vector<char>{ data->bytes(), data->bytes() + data->size() };
+}
+
+// Opaque gray content as an 8 bit grayscale png, a quarter of the pixels of RGBA to deflate
+std::optional<std::vector<char>> encodeGrayPng(SkImage* image, const SkPngEncoder::Options& opt)
+{
+  SkBitmap gray;
+  if (
+    !gray.tryAllocPixels(
+      SkImageInfo::Make(image->width(), image->height(), kGray_8_SkColorType, kOpaque_SkAlphaType)) ||
+    !image->readPixels(nullptr, gray.pixmap(), 0, 0))
+  {
+    return std::nullopt;
+  }
+  SkDynamicMemoryWStream stream;
+  if (!SkPngEncoder::Encode(&stream, gray.pixmap(), opt))
+  {
+    return std::nullopt;
+  }
+  return toVector(stream.detachAsData());
+}
+} // namespace
+
 std::optional<std::vector<char>> encodeImage(
   GrDirectContext* ctx,
   EImageEncode     encode,
   SkImage*         image,
-  int              quality)
+  int              quality,
+  EEncodeProfile   profile)
 {
   quality = std::max(std::min(quality, 100), 0);
+
+  // the content heuristics need the pixels, they are skipped for gpu images
+  std::optional<ColorStats> stats;
+  SkPixmap                  pixmap;
+  if (profile == EEncodeProfile::BALANCED || profile == EEncodeProfile::SMALLEST)
+  {
+    if (image->peekPixels(&pixmap))
+    {
+      stats = analyzeColors(pixmap);
+    }
+  }
+  const bool flat = stats && stats->colorCount <= MAX_PALETTE_COLORS;
+
   if (encode == EImageEncode::IE_PNG)
   {
     SkPngEncoder::Options opt;
-    opt.fZLibLevel = std::max(std::min(9, (100 - quality) / 10), 0);
-    if (auto data = SkPngEncoder::Encode(ctx, image, opt))
+    switch (profile)
     {
-      return std::vector<char>{ data->bytes(), data->bytes() + data->size() };
+      case EEncodeProfile::FAST:
+        opt.fZLibLevel = 1;
+        opt.fFilterFlags = SkPngEncoder::FilterFlag::kSub;
+        break;
+      case EEncodeProfile::BALANCED:
+        opt.fZLibLevel = 6;
+        opt.fFilterFlags = SkPngEncoder::FilterFlag::kAll;
+        break;
+      case EEncodeProfile::SMALLEST:
+        opt.fZLibLevel = 9;
+        opt.fFilterFlags = SkPngEncoder::FilterFlag::kAll;
+        break;
+      default:
+        opt.fZLibLevel = std::max(std::min(9, (100 - quality) / 10), 0);
+        break;
+    }
+    if (profile == EEncodeProfile::SMALLEST && stats && stats->gray && stats->opaque)
+    {
+      if (auto data = encodeGrayPng(image, opt))
+      {
+        return data;
+      }
+    }
+    if (auto data = toVector(SkPngEncoder::Encode(ctx, image, opt)))
+    {
+      return data;
     }
   }
   else if (encode == EImageEncode::IE_JPEG)
   {
     SkJpegEncoder::Options opt;
     opt.fQuality = quality;
-    if (auto data = SkJpegEncoder::Encode(ctx, image, opt))
+    if (profile == EEncodeProfile::BALANCED && quality >= 90)
+    {
+      opt.fDownsample = SkJpegEncoder::Downsample::k444; // keeps the colors of thin text edges
+    }
+    if (auto data = toVector(SkJpegEncoder::Encode(ctx, image, opt)))
     {
-      return std::vector<char>{ data->bytes(), data->bytes() + data->size() };
+      return data;
     }
   }
   else if (encode == EImageEncode::IE_WEBP)
   {
     SkWebpEncoder::Options opt;
     opt.fQuality = quality;
-    if (auto data = SkWebpEncoder::Encode(ctx, image, opt))
+    if (flat)
+    {
+      // lossless is smaller and exact for flat UI art, the quality is the effort then
+      opt.fCompression = SkWebpEncoder::Compression::kLossless;
+      opt.fQuality = profile == EEncodeProfile::SMALLEST ? 100 : 50;
+    }
+    if (auto data = toVector(SkWebpEncoder::Encode(ctx, image, opt)))
     {
-      return std::vector<char>{ data->bytes(), data->bytes() + data->size() };
+      return data;
     }
   }
   else
@@ -98,84 +222,231 @@ std::optional<std::vector<char>> encodeImage(
   return std::nullopt;
 }
 
-void makePDF(layer::FrameNode* frame, const PDFOptions& opts, std::ostream& os)
+static bool makePDF(layer::FrameNode* frame, const PDFOptions& opts, SkWStream* stream)
 {
-  SkStdOStream skos(os);
-  auto         pdfDoc = SkPDF::MakeDocument(&skos);
-  if (pdfDoc)
+  auto pdfDoc = SkPDF::MakeDocument(stream);
+  if (!pdfDoc)
   {
-    int       w = opts.extend[0];
-    int       h = opts.extend[1];
-    SkCanvas* pdfCanvas = pdfDoc->beginPage(w, h);
-    if (pdfCanvas)
-    {
-      renderInternal(pdfCanvas, frame);
-    }
-    pdfDoc->endPage();
-    pdfDoc->close();
+    DEBUG("Create PDF Doc failed\n");
+    return false;
   }
-  else
+  int       w = opts.extend[0];
+  int       h = opts.extend[1];
+  SkCanvas* pdfCanvas = pdfDoc->beginPage(w, h);
+  if (pdfCanvas)
   {
-    DEBUG("Create PDF Doc failed\n");
+    renderInternal(pdfCanvas, frame);
   }
+  pdfDoc->endPage();
+  pdfDoc->close();
+  return pdfCanvas != nullptr;
+}
+
+static bool makeSVG(layer::FrameNode* frame, const SVGOptions& opts, SkWStream* stream)
+{
+  auto rect = SkRect::MakeWH(opts.extend[0], opts.extend[1]);
+  if (auto svgCanvas = SkSVGCanvas::Make(rect, stream))
+  {
+    renderInternal(svgCanvas.get(), frame);
+    return true; // the document is finished when the canvas goes away
+  }
+  DEBUG("Create SVG Canvas failed\n");
+  return false;
+}
+
+void makePDF(layer::FrameNode* frame, const PDFOptions& opts, std::ostream& os)
+{
+  SkStdOStream skos(os);
+  makePDF(frame, opts, &skos);
+}
+
+bool makePDF(layer::FrameNode* frame, const PDFOptions& opts, const WriteProc& write)
+{
+  SkCallbackWStream stream(write);
+  return makePDF(frame, opts, &stream) && stream.good();
 }
 
 std::optional<std::vector<char>> makePDF(layer::FrameNode* frame, const PDFOptions& opts)
 {
-  std::stringstream data;
-  layer::exporter::makePDF(frame, opts, data);
-  auto d = data.str();
-  return std::vector<char>{ d.begin(), d.end() };
+  std::vector<char> data;
+  SkVectorWStream   stream(data);
+  if (!makePDF(frame, opts, &stream))
+  {
+    return std::nullopt;
+  }
+  return data;
 }
 
 std::optional<std::vector<char>> makeSVG(layer::FrameNode* frame, const SVGOptions& opts)
 {
-  std::stringstream data;
-  makeSVG(frame, opts, data);
-  auto d = data.str();
-  return std::vector<char>{ d.begin(), d.end() };
+  std::vector<char> data;
+  SkVectorWStream   stream(data);
+  if (!makeSVG(frame, opts, &stream))
+  {
+    return std::nullopt;
+  }
+  return data;
 }
 
 void makeSVG(layer::FrameNode* frame, const SVGOptions& opts, std::ostream& os)
 {
-  auto         rect = SkRect::MakeWH(opts.extend[0], opts.extend[1]);
   SkStdOStream skos(os);
-  auto         svgCanvas = SkSVGCanvas::Make(rect, &skos);
-  if (svgCanvas)
+  makeSVG(frame, opts, &skos);
+}
+
+bool makeSVG(layer::FrameNode* frame, const SVGOptions& opts, const WriteProc& write)
+{
+  SkCallbackWStream stream(write);
+  return makeSVG(frame, opts, &stream) && stream.good();
+}
+
+struct PDFDocument::Impl
+{
+  WriteProc         write;
+  SkCallbackWStream stream;
+  sk_sp<SkDocument> doc;
+
+  Impl(WriteProc proc)
+    : write(std::move(proc))
+    , stream(write)
+    , doc(SkPDF::MakeDocument(&stream)) // a single document shares fonts and images across pages
   {
-    renderInternal(svgCanvas.get(), frame);
   }
-  else
+};
+
+PDFDocument::PDFDocument(WriteProc write)
+  : d_impl(std::make_unique<Impl>(std::move(write)))
+{
+}
+
+PDFDocument::~PDFDocument()
+{
+  close();
+}
+
+bool PDFDocument::addPage(layer::FrameNode* frame, const PDFOptions& opts)
+{
+  if (!d_impl->doc || !d_impl->stream.good())
+  {
+    return false;
+  }
+  auto canvas = d_impl->doc->beginPage(opts.extend[0], opts.extend[1]);
+  if (!canvas)
+  {
+    DEBUG("Begin PDF page failed\n");
+    return false;
+  }
+  renderInternal(canvas, frame);
+  d_impl->doc->endPage();
+  return d_impl->stream.good();
+}
+
+bool PDFDocument::close()
+{
+  if (!d_impl->doc)
+  {
+    return false;
+  }
+  d_impl->doc->close();
+  d_impl->doc = nullptr;
+  return d_impl->stream.good();
+}
+
+SkImageInfo rawImageInfo(const ImageOptions& opts)
+{
+  return SkImageInfo::Make(
+    opts.extend[0],
+    opts.extend[1],
+    opts.pixelFormat == EPixelFormat::BGRA_8888 ? kBGRA_8888_SkColorType : kRGBA_8888_SkColorType,
+    opts.premultiplied ? kPremul_SkAlphaType : kUnpremul_SkAlphaType);
+}
+
+bool readPixels(const ImageOptions& opts, SkSurface* surface, void* dst, std::size_t rowBytes)
+{
+  const auto info = rawImageInfo(opts);
+  if (!dst || rowBytes < info.minRowBytes())
   {
-    DEBUG("Create SVG Canvas failed\n");
+    DEBUG("Invalid destination for raw pixels");
+    return false;
   }
+  // no snapshot, the pixels are converted while being copied out of the surface
+  return surface->readPixels(info, dst, rowBytes, opts.position[0], opts.position[1]);
+}
+
+bool readPixels(const ImageOptions& opts, SkImage* image, void* dst, std::size_t rowBytes)
+{
+  ASSERT(image && !image->isTextureBacked());
+  const auto info = rawImageInfo(opts).makeWH(image->width(), image->height());
+  if (!dst || rowBytes < info.minRowBytes())
+  {
+    DEBUG("Invalid destination for raw pixels");
+    return false;
+  }
+  return image->readPixels(nullptr, info, dst, rowBytes, 0, 0);
 }
 
 std::optional<std::vector<char>> makeImage(const ImageOptions& opts, SkSurface* surface)
 {
-  auto ctx = surface->getCanvas()->recordingContext();
+  if (opts.encode == EImageEncode::IE_RAW)
+  {
+    const auto        rowBytes = rawImageInfo(opts).minRowBytes();
+    std::vector<char> pixels(rowBytes * opts.extend[1]);
+    if (readPixels(opts, surface, pixels.data(), rowBytes))
+    {
+      return pixels;
+    }
+    DEBUG("Failed to read raw pixels");
+    return std::nullopt;
+  }
+
+  auto ctx = surface->getCanvas()->recordingContext(); // null for a raster surface
   if (
     auto image = surface->makeImageSnapshot(
       SkIRect::MakeXYWH(opts.position[0], opts.position[1], opts.extend[0], opts.extend[1])))
   {
-    if (opts.encode != EImageEncode::IE_RAW)
+    auto dc = ctx ? ctx->asDirectContext() : nullptr;
+    if (ctx && !dc)
     {
-      if (auto dc = ctx->asDirectContext())
-      {
-        return encodeImage(dc, opts.encode, image.get(), opts.quality);
-      }
-      else
-      {
-        DEBUG("Failed to get direct context");
-        return std::nullopt;
-      }
-    }
-    else
-    {
-      DEBUG("raw data is not supported now");
+      DEBUG("Failed to get direct context");
       return std::nullopt;
     }
+    return encodeImage(dc, opts.encode, image.get(), opts.quality, opts.profile);
+  }
+  return std::nullopt;
+}
+
+sk_sp<SkImage> makeSnapshot(const ImageOptions& opts, SkSurface* surface)
+{
+  auto ctx = surface->getCanvas()->recordingContext();
+  auto image = surface->makeImageSnapshot(
+    SkIRect::MakeXYWH(opts.position[0], opts.position[1], opts.extend[0], opts.extend[1]));
+  if (!image || !ctx)
+  {
+    return image; // a raster snapshot is copied on write, reusing the surface is fine
+  }
+  auto dc = ctx->asDirectContext();
+  if (!dc)
+  {
+    DEBUG("Failed to get direct context");
+    return nullptr;
+  }
+  return image->makeRasterImage(dc);
+}
+
+std::optional<std::vector<char>> encodeSnapshot(const ImageOptions& opts, SkImage* image)
+{
+  ASSERT(image && !image->isTextureBacked());
+  if (opts.encode != EImageEncode::IE_RAW)
+  {
+    return encodeImage(nullptr, opts.encode, image, opts.quality, opts.profile);
+  }
+  const auto        rowBytes = rawImageInfo(opts).makeWH(image->width(), 1).minRowBytes();
+  std::vector<char> pixels(rowBytes * image->height());
+  if (readPixels(opts, image, pixels.data(), rowBytes))
+  {
+    return pixels;
   }
+  DEBUG("Failed to read raw pixels");
   return std::nullopt;
 }
 } // namespace VGG::layer::exporter
@@ -112,6 +112,12 @@ MaskMap* getMaskMap()
   return &s_maskMap;
 }
 
+void purgeDocumentCaches()
+{
+  getGlobalImageStackCache()->purge();
+  getMaskMap()->clear();
+}
+
 namespace
 {
 void updateMaskMapInternal(PaintNode* p)
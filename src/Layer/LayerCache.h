@@ -47,4 +47,8 @@ std::pair<sk_sp<SkImage>, int> loadImageFromStack(const std::string& imageGUID,
 MaskMap* getMaskMap();
 void     updateMaskMap(PaintNode* p);
 
+// Drops the decoded images and masks of the current document, they are keyed by guid and would
+// be served to the next document otherwise. Blenders and effects are kept.
+void purgeDocumentCaches();
+
 } // namespace VGG::layer
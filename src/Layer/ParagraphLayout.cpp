@@ -21,6 +21,7 @@
 #include "Layer/SkiaFontManagerProxy.hpp"
 #include "Layer/VSkFontMgr.hpp"
 #include "VSkia.hpp"
+#include "Utility/Trace.hpp"
 
 #include <algorithm>
 #include <core/SkColor.h>
@@ -406,6 +407,7 @@ bool RichTextBlock::ensureBuild(TextLayoutMode mode)
       assert(d.builder);
       paragraphCache.push_back(d.build());
     }
+    VGG_TRACE_COUNT(PARAGRAPHS_SHAPED, paragraph.size());
     m_state = BUILT;
   }
   if (m_state >= BUILT)
@@ -20,6 +20,7 @@
 
 #include "Layer/Core/ZoomerNode.hpp"
 #include "Layer/LRUCache.hpp"
+#include "Utility/Trace.hpp"
 #include "core/SkCanvas.h"
 #include "core/SkImage.h"
 #include "core/SkPicture.h"
@@ -109,6 +110,7 @@ sk_sp<SkImage> rasterTile(
   const SkRect&   rect)
 {
   ASSERT(surface);
+  VGG_TRACE_COUNT(TILES_RASTERED, 1);
   auto canvas = surface->getCanvas();
   canvas->clear(SK_ColorTRANSPARENT);
   canvas->save();
@@ -148,6 +150,10 @@ std::vector<Rasterizer::Tile> rasterOrGetTiles(
         tileState->first = true;
         tileState->second.image = rasterTile(surface, picture, cache.rasterMatrix, rect);
       }
+      else
+      {
+        VGG_TRACE_COUNT(CACHE_HITS, 1);
+      }
       tiles.push_back(tileState->second);
     }
     else
@@ -16,6 +16,7 @@
 
 #include "Layer/Core/ResourceManager.hpp"
 #include "Layer/Core/ResourceProvider.hpp"
+#include "LayerCache.h"
 
 namespace
 {
@@ -31,6 +32,7 @@ void setGlobalResourceProvider(std::unique_ptr<ResourceProvider> provider)
   if (g_provider != provider)
   {
     g_provider = std::move(provider);
+    getGlobalImageStackCache()->purge(); // decoded by guid from the previous provider
   }
 }
 
@@ -14,13 +14,15 @@
  * limitations under the License.
  */
 #pragma once
+#include <functional>
 #include <ostream>
+#include <vector>
 #include <core/SkStream.h>
 #include "Utility/Log.hpp"
 class SkStdOStream : public SkWStream
 {
-  std::ostream&          m_os;
-  std::ostream::pos_type m_begin{ 0 };
+  std::ostream& m_os;
+  size_t        m_written{ 0 }; // counted, tellp fails on pipes and sockets
 
 public:
   SkStdOStream(const SkStdOStream&) = delete;
@@ -28,17 +30,73 @@ public:
   SkStdOStream(std::ostream& os)
     : m_os(os)
   {
-    m_begin = m_os.tellp();
   }
 
   virtual bool write(const void* buffer, size_t size) override
   {
     m_os.write((char*)buffer, size);
+    m_written += size;
     return m_os.good();
   }
 
   virtual size_t bytesWritten() const override
   {
-    return m_os.tellp() - m_begin;
+    return m_written;
+  }
+};
+
+class SkCallbackWStream : public SkWStream
+{
+  const std::function<bool(const char*, size_t)>& m_write;
+  size_t                                          m_written{ 0 };
+  bool                                            m_good{ true };
+
+public:
+  SkCallbackWStream(const SkCallbackWStream&) = delete;
+  SkCallbackWStream& operator=(const SkCallbackWStream&) = delete;
+  SkCallbackWStream(const std::function<bool(const char*, size_t)>& write)
+    : m_write(write)
+  {
+  }
+
+  virtual bool write(const void* buffer, size_t size) override
+  {
+    m_good = m_good && m_write((const char*)buffer, size); // stop calling once aborted
+    m_written += size;
+    return m_good;
+  }
+
+  virtual size_t bytesWritten() const override
+  {
+    return m_written;
+  }
+
+  bool good() const
+  {
+    return m_good;
+  }
+};
+
+class SkVectorWStream : public SkWStream
+{
+  std::vector<char>& m_data;
+
+public:
+  SkVectorWStream(const SkVectorWStream&) = delete;
+  SkVectorWStream& operator=(const SkVectorWStream&) = delete;
+  SkVectorWStream(std::vector<char>& data)
+    : m_data(data)
+  {
+  }
+
+  virtual bool write(const void* buffer, size_t size) override
+  {
+    m_data.insert(m_data.end(), (const char*)buffer, (const char*)buffer + size);
+    return true;
+  }
+
+  virtual size_t bytesWritten() const override
+  {
+    return m_data.size();
   }
 };
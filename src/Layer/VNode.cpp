@@ -16,10 +16,51 @@
 #include "Layer/Core/VNode.hpp"
 #include "Layer/Core/EventManager.hpp"
 #include "Layer/StackTrace.hpp"
+#include "Utility/Trace.hpp"
+
+#include <unordered_map>
+#include <utility>
 
 namespace VGG::layer
 {
 
+namespace
+{
+// node: damage, of the outermost InvalidationBatch of the thread
+struct DeferredInvalidations
+{
+  std::vector<std::pair<VNodeRef, bool>>   nodes;
+  std::unordered_map<const VNode*, size_t> index;
+  bool                                     active{ false };
+};
+thread_local DeferredInvalidations t_deferred;
+} // namespace
+
+VNode::InvalidationBatch::InvalidationBatch()
+  : m_outermost(!t_deferred.active)
+{
+  t_deferred.active = true;
+}
+
+VNode::InvalidationBatch::~InvalidationBatch()
+{
+  if (!m_outermost)
+  {
+    return;
+  }
+  t_deferred.active = false;
+  auto nodes = std::move(t_deferred.nodes);
+  t_deferred.nodes.clear();
+  t_deferred.index.clear();
+  for (auto& [node, damage] : nodes)
+  {
+    if (auto p = node.lock(); p)
+    {
+      p->invalidate(damage);
+    }
+  }
+}
+
 void Revalidation::emit(const Bounds& bounds, const glm::mat3& ctm, VNode* node)
 {
   if (bounds.valid() == false)
@@ -98,16 +139,28 @@ void VNode::unobserve(VNodePtr sender)
 
 void VNode::update()
 {
-  if (m_state & UPDATE)
+  if (m_queued.load(std::memory_order_acquire))
   {
     return;
   }
   EventManager::postEvent({ this, ENodeEvent::UPDATE });
-  m_state |= UPDATE;
 }
 
 void VNode::invalidate(bool damage)
 {
+  if (t_deferred.active)
+  {
+    if (auto [it, inserted] = t_deferred.index.try_emplace(this, t_deferred.nodes.size()); inserted)
+    {
+      t_deferred.nodes.emplace_back(this, damage);
+    }
+    else
+    {
+      t_deferred.nodes[it->second].second |= damage;
+    }
+    return;
+  }
+
   ScopedState state(*this, TRAVERSALING);
   if (state.wasSet())
   {
@@ -116,6 +169,7 @@ void VNode::invalidate(bool damage)
   }
   if (isInvalid() && (!damage || m_state & DAMAGE))
     return;
+  VGG_TRACE_COUNT(NODES_INVALIDATED, 1);
 #ifdef VGG_LAYER_DEBUG
   std::string indent(depth(), '\t');
   VGG_TRACE_DEV(indent + dbgInfo);
@@ -147,6 +201,7 @@ const Bounds& VNode::revalidate(Revalidation* inv, const glm::mat3& ctm)
   }
   if (!isInvalid())
     return m_bounds;
+  VGG_TRACE_COUNT(NODES_REVALIDATED, 1);
 #ifdef VGG_LAYER_DEBUG
   std::string indent(depth(), '\t');
   VGG_TRACE_DEV(indent + dbgInfo);
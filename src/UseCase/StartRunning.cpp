@@ -26,14 +26,14 @@ StartRunning::StartRunning(std::shared_ptr<Daruma> model)
 {
   ASSERT(model);
 
-  if (model->layoutDoc())
+  const auto layoutJson = model->layoutDoc() ? model->layoutDoc()->content() : nlohmann::json();
+  if (auto designModel = model->designModel())
   {
-    m_expander.reset(
-      new ExpandSymbol(model->designDoc()->content(), model->layoutDoc()->content()));
+    m_expander.reset(new ExpandSymbol(std::move(designModel), layoutJson));
   }
   else
   {
-    m_expander.reset(new ExpandSymbol(model->designDoc()->content()));
+    m_expander.reset(new ExpandSymbol(model->designDoc()->content(), layoutJson));
   }
 
   auto result = (*m_expander)();
@@ -0,0 +1,188 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Utility/Trace.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+
+namespace VGG
+{
+
+namespace
+{
+constexpr std::size_t DEFAULT_CAPACITY = 1 << 14;
+
+constexpr const char* COUNTER_NAMES[] = {
+  "tilesRastered",
+  "cacheHits",
+  "nodesRevalidated",
+  "nodesInvalidated",
+  "paragraphsShaped",
+};
+static_assert(std::size(COUNTER_NAMES) == std::size_t(Tracer::ECounter::COUNT));
+} // namespace
+
+Tracer& Tracer::sharedInstance()
+{
+  static Tracer s_sharedInstance;
+  return s_sharedInstance;
+}
+
+Tracer::Tracer()
+  : m_origin(Clock::now())
+{
+  // VGG_TRACE=1 traces from startup, before the sdk can switch it on
+  if (const auto env = std::getenv("VGG_TRACE"); env && std::strcmp(env, "0") != 0)
+  {
+    setEnabled(true);
+  }
+}
+
+void Tracer::setEnabled(bool enabled)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (enabled && m_events.empty())
+  {
+    m_events.resize(DEFAULT_CAPACITY);
+  }
+  for (auto& c : m_counters)
+  {
+    c.store(0, std::memory_order_relaxed);
+  }
+  m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Tracer::setCapacity(std::size_t capacity)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_events.assign(std::max<std::size_t>(capacity, 1), Event{});
+  m_next = 0;
+  m_wrapped = false;
+}
+
+void Tracer::clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_next = 0;
+  m_wrapped = false;
+}
+
+void Tracer::addZone(const char* name, Clock::time_point begin, Clock::time_point end)
+{
+  if (!enabled())
+  {
+    return;
+  }
+
+  Event event;
+  event.name = name;
+  event.threadId = currentThreadId();
+  event.begin = toMicroseconds(begin);
+  event.duration = toMicroseconds(end) - event.begin;
+  push(event);
+}
+
+void Tracer::markFrame()
+{
+  if (!enabled())
+  {
+    return;
+  }
+
+  Event event;
+  event.threadId = currentThreadId();
+  event.begin = toMicroseconds(Clock::now());
+  for (std::size_t i = 0; i < std::size_t(ECounter::COUNT); ++i)
+  {
+    event.counters[i] = m_counters[i].exchange(0, std::memory_order_relaxed);
+  }
+  push(event);
+}
+
+std::string Tracer::dumpChromeTrace() const
+{
+  auto events = nlohmann::json::array();
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto                  count = m_wrapped ? m_events.size() : m_next;
+    const auto                  first = m_wrapped ? m_next : 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const auto& e = m_events[(first + i) % m_events.size()];
+      if (e.name)
+      {
+        events.push_back({ { "name", e.name },
+                           { "ph", "X" },
+                           { "ts", e.begin },
+                           { "dur", e.duration },
+                           { "pid", 1 },
+                           { "tid", e.threadId } });
+      }
+      else
+      {
+        auto args = nlohmann::json::object();
+        for (std::size_t c = 0; c < std::size_t(ECounter::COUNT); ++c)
+        {
+          args[COUNTER_NAMES[c]] = e.counters[c];
+        }
+        events.push_back({ { "name", "frame" },
+                           { "ph", "C" },
+                           { "ts", e.begin },
+                           { "pid", 1 },
+                           { "tid", e.threadId },
+                           { "args", std::move(args) } });
+      }
+    }
+  }
+
+  nlohmann::json trace{ { "traceEvents", std::move(events) }, { "displayTimeUnit", "ms" } };
+  return trace.dump();
+}
+
+void Tracer::push(const Event& event)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_events.empty())
+  {
+    return;
+  }
+
+  m_events[m_next] = event;
+  if (++m_next == m_events.size())
+  {
+    m_next = 0;
+    m_wrapped = true;
+  }
+}
+
+int64_t Tracer::toMicroseconds(Clock::time_point time) const
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(time - m_origin).count();
+}
+
+uint32_t Tracer::currentThreadId()
+{
+  static std::atomic<uint32_t> s_nextId{ 1 };
+  thread_local const uint32_t  s_id = s_nextId.fetch_add(1, std::memory_order_relaxed);
+  return s_id;
+}
+
+} // namespace VGG
@@ -16,7 +16,7 @@
 
 #include "Utility/VggString.hpp"
 
-#include <numeric>
+#include <iterator>
 
 namespace VGG::Helper
 {
@@ -28,11 +28,20 @@ std::string join(const std::vector<std::string>& instanceIdStack, const std::str
     return {};
   }
 
-  return std::accumulate(
-    std::next(instanceIdStack.begin()),
-    instanceIdStack.end(),
-    instanceIdStack[0], // start with first element
-    [&](const std::string& a, const std::string& b) { return a + separator + b; });
+  std::size_t size = separator.size() * (instanceIdStack.size() - 1);
+  for (const auto& id : instanceIdStack)
+  {
+    size += id.size();
+  }
+
+  std::string result;
+  result.reserve(size);
+  result.append(instanceIdStack[0]);
+  for (auto it = std::next(instanceIdStack.begin()); it != instanceIdStack.end(); ++it)
+  {
+    result.append(separator).append(*it);
+  }
+  return result;
 }
 
 std::vector<std::string> split(const std::string& s, const std::string& separator)
@@ -0,0 +1,197 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Application/Animate.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+using namespace VGG;
+using namespace std::chrono_literals;
+
+namespace
+{
+// Reads its values from the tracks like NumberAnimate does
+class TestAnimate : public Animate
+{
+public:
+  using Animate::Animate;
+  using Animate::getTrackValues;
+  using Animate::start;
+
+  std::size_t         offset{ 0 };
+  std::vector<double> values;
+
+  void setFromTo(const std::vector<double>& from, const std::vector<double>& to)
+  {
+    offset = addTracks(from, to);
+    values = from;
+  }
+
+  void timerCallback() override
+  {
+    Animate::timerCallback();
+    auto track = getTrackValues(offset);
+    values.assign(track, track + values.size());
+  }
+};
+
+// Ends at `to` right away, through the per value fallback of Interpolator::interpolate
+class JumpInterpolator : public Interpolator
+{
+public:
+  double operator()(milliseconds, double, double to, milliseconds) override
+  {
+    return to;
+  }
+};
+} // namespace
+
+TEST(LinearInterpolatorTest, InterpolateMatchesPerValue)
+{
+  LinearInterpolator        sut;
+  const std::vector<double> from{ 0, 10, -4, 1.5 };
+  const std::vector<double> to{ 10, 20, 4, 1.5 };
+  std::vector<double>       out(from.size());
+
+  for (auto passed : { 0ms, 1ms, 25ms, 50ms, 99ms })
+  {
+    sut.interpolate(passed, 100ms, from.data(), to.data(), out.data(), out.size());
+    for (std::size_t i = 0; i < out.size(); ++i)
+    {
+      EXPECT_DOUBLE_EQ(out[i], sut(passed, from[i], to[i], 100ms))
+        << "value " << i << " at " << passed.count() << "ms";
+    }
+  }
+
+  sut.interpolate(25ms, 100ms, from.data(), to.data(), out.data(), out.size());
+  EXPECT_EQ(out, (std::vector<double>{ 2.5, 12.5, -2, 1.5 }));
+}
+
+TEST(LinearInterpolatorTest, InterpolateEndsAtTo)
+{
+  LinearInterpolator        sut;
+  const std::vector<double> from{ 0.1, 0.2 };
+  const std::vector<double> to{ 0.3, 0.7 };
+  std::vector<double>       out(from.size());
+
+  sut.interpolate(100ms, 100ms, from.data(), to.data(), out.data(), out.size());
+  EXPECT_EQ(out, to);
+
+  out.assign(out.size(), 0);
+  sut.interpolate(150ms, 100ms, from.data(), to.data(), out.data(), out.size());
+  EXPECT_EQ(out, to);
+}
+
+TEST(LinearInterpolatorTest, InterpolateNothing)
+{
+  LinearInterpolator sut;
+  sut.interpolate(10ms, 100ms, nullptr, nullptr, nullptr, 0);
+}
+
+class AnimateTracksTestSuite : public ::testing::Test
+{
+protected:
+  AnimateManage m_manage;
+
+  void SetUp() override
+  {
+    m_manage.clock().setMode(AnimationClock::EMode::MANUAL);
+  }
+
+  // root <- child <- grandchild
+  std::shared_ptr<TestAnimate> makeTree(
+    std::shared_ptr<Interpolator>  interpolator,
+    std::shared_ptr<TestAnimate>&  child,
+    std::shared_ptr<TestAnimate>&  grandchild)
+  {
+    auto root = std::make_shared<TestAnimate>(100ms, 10ms, std::move(interpolator));
+    child = std::make_shared<TestAnimate>(root.get());
+    root->addChildAnimate(child);
+    grandchild = std::make_shared<TestAnimate>(child.get());
+    child->addChildAnimate(grandchild);
+
+    child->setFromTo({ 0, 10 }, { 10, 20 });
+    grandchild->setFromTo({ -4 }, { 4 });
+    root->setFromTo({ 100 }, { 0 });
+    return root;
+  }
+
+  void start(std::shared_ptr<TestAnimate> root)
+  {
+    root->start();
+    m_manage.addAnimate(root);
+  }
+};
+
+TEST_F(AnimateTracksTestSuite, StoredContiguouslyInRoot)
+{
+  std::shared_ptr<TestAnimate> child;
+  std::shared_ptr<TestAnimate> grandchild;
+  auto root = makeTree(std::make_shared<LinearInterpolator>(), child, grandchild);
+
+  EXPECT_EQ(child->offset, 0u);
+  EXPECT_EQ(grandchild->offset, 2u);
+  EXPECT_EQ(root->offset, 3u);
+
+  // one store, owned by the root, starting at the from values
+  const double* store = root->getTrackValues(0);
+  EXPECT_EQ(child->getTrackValues(0), store);
+  EXPECT_EQ(grandchild->getTrackValues(grandchild->offset), store + 2);
+  EXPECT_EQ(std::vector<double>(store, store + 4), (std::vector<double>{ 0, 10, -4, 100 }));
+
+  root->stop();
+  EXPECT_EQ(child->offset, 0u); // unchanged, the store was cleared
+  auto other = std::make_shared<TestAnimate>(root.get());
+  other->setFromTo({ 1 }, { 2 });
+  EXPECT_EQ(other->offset, 0u);
+}
+
+TEST_F(AnimateTracksTestSuite, InterpolatedInOnePassPerTick)
+{
+  std::shared_ptr<TestAnimate> child;
+  std::shared_ptr<TestAnimate> grandchild;
+  auto root = makeTree(std::make_shared<LinearInterpolator>(), child, grandchild);
+  start(root);
+
+  m_manage.clock().advance(25ms);
+  EXPECT_EQ(child->values, (std::vector<double>{ 2.5, 12.5 }));
+  EXPECT_EQ(grandchild->values, (std::vector<double>{ -2 }));
+  EXPECT_EQ(root->values, (std::vector<double>{ 75 }));
+  EXPECT_FALSE(root->isFinished());
+
+  m_manage.clock().advance(75ms);
+  EXPECT_EQ(child->values, (std::vector<double>{ 10, 20 }));
+  EXPECT_EQ(grandchild->values, (std::vector<double>{ 4 }));
+  EXPECT_EQ(root->values, (std::vector<double>{ 0 }));
+  EXPECT_TRUE(root->isFinished());
+}
+
+TEST_F(AnimateTracksTestSuite, CustomInterpolatorPerValue)
+{
+  std::shared_ptr<TestAnimate> child;
+  std::shared_ptr<TestAnimate> grandchild;
+  auto root = makeTree(std::make_shared<JumpInterpolator>(), child, grandchild);
+  start(root);
+
+  m_manage.clock().advance(10ms);
+  EXPECT_EQ(child->values, (std::vector<double>{ 10, 20 }));
+  EXPECT_EQ(grandchild->values, (std::vector<double>{ 4 }));
+  EXPECT_EQ(root->values, (std::vector<double>{ 0 }));
+  EXPECT_FALSE(root->isFinished()); // finishes at the duration, not at the values
+}
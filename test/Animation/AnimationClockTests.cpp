@@ -0,0 +1,59 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Application/AnimationClock.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace VGG;
+using namespace std::chrono_literals;
+
+class AnimationClockTestSuite : public ::testing::Test
+{
+protected:
+  std::vector<AnimationClock::TimePoint> m_ticks;
+  AnimationClock m_sut{ [this](AnimationClock::TimePoint time) { m_ticks.push_back(time); } };
+};
+
+TEST_F(AnimationClockTestSuite, FrameTick)
+{
+  // When
+  m_sut.tick();
+  m_sut.advance(16ms);
+
+  // Then
+  ASSERT_EQ(m_ticks.size(), 1);
+}
+
+TEST_F(AnimationClockTestSuite, ManualStep)
+{
+  // Given
+  m_sut.setMode(AnimationClock::EMode::MANUAL);
+  const auto start = m_sut.now();
+
+  // When
+  m_sut.tick();
+  m_sut.advance(16ms);
+  m_sut.advance(17ms);
+
+  // Then
+  ASSERT_EQ(m_ticks.size(), 2);
+  EXPECT_EQ(m_ticks[0] - start, 16ms);
+  EXPECT_EQ(m_ticks[1] - start, 33ms);
+  EXPECT_EQ(m_sut.now(), m_ticks[1]);
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "Application/RunLoop.hpp"
+#include "Utility/VggTimer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace VGG;
+
+class RunLoopTestSuite : public ::testing::Test
+{
+protected:
+  std::shared_ptr<RunLoop> m_sut = RunLoop::sharedInstance();
+
+  void TearDown() override
+  {
+    while (!m_sut->empty())
+    {
+      m_sut->dispatch();
+    }
+  }
+};
+
+TEST_F(RunLoopTestSuite, DispatchWithinBudget)
+{
+  auto count = 0;
+  auto worker = m_sut->thread().create_coordinator().get_worker();
+  for (auto i = 0; i < 3; ++i)
+  {
+    worker.schedule(
+      [&count](const rxcpp::schedulers::schedulable&)
+      {
+        count++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  // at least one item runs even without budget
+  EXPECT_TRUE(m_sut->dispatch(std::chrono::microseconds(0)));
+  EXPECT_EQ(count, 1);
+
+  EXPECT_FALSE(m_sut->dispatch());
+  EXPECT_EQ(count, 3);
+}
+
+TEST_F(RunLoopTestSuite, NextDeadline)
+{
+  EXPECT_FALSE(m_sut->nextDeadline());
+
+  const auto before = RunLoop::Clock::now();
+  Timer      timer{ 0.1, []() {} };
+  timer.setup();
+
+  auto deadline = m_sut->nextDeadline();
+  ASSERT_TRUE(deadline);
+  EXPECT_GE(*deadline, before + std::chrono::milliseconds(100));
+}
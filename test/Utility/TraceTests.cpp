@@ -0,0 +1,99 @@
+/*
+ * Copyright 2023-2024 VeryGoodGraphics LTD <bd@verygoodgraphics.com>
+ *
+ * Licensed under the VGG License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.verygoodgraphics.com/licenses/LICENSE-1.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "Utility/Trace.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace VGG;
+
+class TraceTestSuite : public ::testing::Test
+{
+protected:
+  Tracer& m_sut = Tracer::sharedInstance();
+
+  void SetUp() override
+  {
+    m_sut.setEnabled(true);
+    m_sut.clear();
+  }
+
+  void TearDown() override
+  {
+    m_sut.setEnabled(false);
+    m_sut.setCapacity(1 << 14);
+  }
+};
+
+TEST_F(TraceTestSuite, Disabled)
+{
+  m_sut.setEnabled(false);
+  {
+    VGG_TRACE_ZONE("zone");
+  }
+  m_sut.markFrame();
+
+  auto trace = nlohmann::json::parse(m_sut.dumpChromeTrace());
+  EXPECT_TRUE(trace["traceEvents"].empty());
+}
+
+TEST_F(TraceTestSuite, ZonesAndCounters)
+{
+  {
+    VGG_TRACE_ZONE("render");
+    VGG_TRACE_COUNT(TILES_RASTERED, 3);
+  }
+  std::thread([]() { VGG_TRACE_ZONE("worker"); }).join();
+  m_sut.markFrame();
+
+  auto        trace = nlohmann::json::parse(m_sut.dumpChromeTrace());
+  const auto& events = trace["traceEvents"];
+  ASSERT_EQ(events.size(), 3u);
+
+  EXPECT_EQ(events[0]["name"], "render");
+  EXPECT_EQ(events[0]["ph"], "X");
+  EXPECT_EQ(events[1]["name"], "worker");
+  EXPECT_NE(events[0]["tid"], events[1]["tid"]);
+
+  EXPECT_EQ(events[2]["ph"], "C");
+  EXPECT_EQ(events[2]["args"]["tilesRastered"], 3);
+  EXPECT_EQ(events[2]["args"]["cacheHits"], 0);
+}
+
+TEST_F(TraceTestSuite, RingBuffer)
+{
+  m_sut.setCapacity(2);
+  {
+    VGG_TRACE_ZONE("a");
+  }
+  {
+    VGG_TRACE_ZONE("b");
+  }
+  {
+    VGG_TRACE_ZONE("c");
+  }
+
+  auto        trace = nlohmann::json::parse(m_sut.dumpChromeTrace());
+  const auto& events = trace["traceEvents"];
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0]["name"], "b");
+  EXPECT_EQ(events[1]["name"], "c");
+}
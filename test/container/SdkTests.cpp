@@ -15,11 +15,16 @@
  */
 
 #include "Adapter/Environment.hpp"
+#include "Application/ElementUpdateBatch.hpp"
 #include "Entry/Container/Container.hpp"
+#include "Utility/Trace.hpp"
 
 #include "test_config.hpp"
 
 #include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
 
 using namespace VGG;
 class SdkTestSuite : public ::testing::Test
@@ -80,4 +85,61 @@ TEST_F(SdkTestSuite, NextPrevFrame)
     auto id3 = sut()->currentFrameId();
     EXPECT_EQ(id1, id3);
   }
-}
\ No newline at end of file
+}
+TEST_F(SdkTestSuite, UpdateElementPropertiesBatch)
+{
+  std::string filePath = "testDataDir/frame_list/";
+  auto        result = m_container->load(filePath);
+  EXPECT_TRUE(result);
+
+  const auto              frameId = sut()->currentFrameId();
+  app::ElementUpdateBatch batch;
+  const auto              frame = batch.node(frameId);
+  EXPECT_EQ(batch.node(frameId), frame);
+  batch.setOpacity(frame, 0.5);
+  batch.setVisible(frame, false);
+  batch.setSize(frame, 123, 45);
+  batch.setOpacity(batch.node("not-exist-id"), 0.5);
+
+  {
+    std::size_t                     offset = 0;
+    app::ElementUpdateBatch::Handle node = 0;
+    app::ElementUpdateProperty      item;
+    EXPECT_TRUE(batch.read(offset, node, item));
+    EXPECT_EQ(node, frame);
+    ASSERT_TRUE(std::holds_alternative<app::ElementUpdateOpacity>(item));
+    EXPECT_EQ(std::get<app::ElementUpdateOpacity>(item).opacity, 0.5);
+  }
+
+  auto successCount =
+    sut()->updateElementPropertiesBatch(batch.nodeIds(), batch.bytes(), batch.byteSize(), {});
+  EXPECT_EQ(successCount, 3);
+
+  auto property = [this, &frameId](const std::string& type)
+  {
+    return nlohmann::json::parse(
+      sut()->getElementProperty(nlohmann::json{ { "type", type }, { "id", frameId } }.dump()));
+  };
+  EXPECT_DOUBLE_EQ(property("opacity").get<double>(), 0.5);
+  EXPECT_FALSE(property("visible").get<bool>());
+  EXPECT_DOUBLE_EQ(property("width").get<double>(), 123);
+  EXPECT_DOUBLE_EQ(property("height").get<double>(), 45);
+}
+
+TEST_F(SdkTestSuite, ChromeTrace)
+{
+  sut()->setTracingEnabled(true);
+  {
+    TraceZone zone("sdkTest");
+  }
+  Tracer::sharedInstance().markFrame();
+  auto trace = nlohmann::json::parse(sut()->chromeTrace());
+  sut()->setTracingEnabled(false);
+  Tracer::sharedInstance().clear();
+
+  const auto& events = trace["traceEvents"];
+  EXPECT_TRUE(std::any_of(
+    events.begin(),
+    events.end(),
+    [](const nlohmann::json& e) { return e.value("name", "") == "sdkTest"; }));
+}
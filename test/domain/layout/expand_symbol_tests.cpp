@@ -824,4 +824,78 @@ TEST_F(VggExpandSymbolTestSuite, VariableString)
   }
 }
 
+TEST_F(VggExpandSymbolTestSuite, ElementIndexAfterExpanding)
+{
+  // Given
+  std::string  filePath = "testDataDir/symbol/symbol_instance/design.json";
+  auto         design_json = Helper::load_json(filePath);
+  ExpandSymbol sut{ design_json };
+
+  // When
+  auto document = sut().first;
+
+  // Then
+  const std::string id{
+    "98C9A450-A48C-4072-B310-E9E80A20F309__651675C7-452D-48D3-A84A-A6CF6796E3B3__95C02DB7-"
+    "5EC9-4A61-97B1-0FFBE0C30E83"
+  };
+  auto element = document->getElementByKey(id);
+  ASSERT_TRUE(element);
+  EXPECT_EQ(element->id(), id);
+  EXPECT_EQ(document->getElementByIdNumber(element->idNumber()), element);
+
+  // removed subtree is not indexed
+  auto parent = element->parent();
+  ASSERT_TRUE(parent);
+  parent->removeChild(element);
+  EXPECT_FALSE(document->getElementByKey(id));
+  EXPECT_FALSE(document->getElementByIdNumber(element->idNumber()));
+
+  // added subtree is indexed
+  parent->addChild(element);
+  EXPECT_EQ(document->getElementByKey(id), element);
+  element->regenerateId(false);
+  EXPECT_EQ(document->getElementByIdNumber(element->idNumber()), element);
+}
+
+TEST_F(VggExpandSymbolTestSuite, UpdateMasterIdDetachesOldChildren)
+{
+  // Given
+  std::string  filePath = "testDataDir/symbol/symbol_instance/design.json";
+  auto         design_json = Helper::load_json(filePath);
+  ExpandSymbol sut{ design_json };
+  auto         document = sut().first;
+
+  const std::string instanceId{ "98C9A450-A48C-4072-B310-E9E80A20F309" };
+  const std::string descendantId{
+    "98C9A450-A48C-4072-B310-E9E80A20F309__651675C7-452D-48D3-A84A-A6CF6796E3B3__95C02DB7-"
+    "5EC9-4A61-97B1-0FFBE0C30E83"
+  };
+  auto instance =
+    std::dynamic_pointer_cast<Domain::SymbolInstanceElement>(document->getElementByKey(instanceId));
+  ASSERT_TRUE(instance);
+  auto descendant = document->getElementByKey(descendantId);
+  ASSERT_TRUE(descendant);
+
+  // When
+  auto oldChildren = instance->updateMasterId(instance->masterId());
+
+  // Then
+  ASSERT_FALSE(oldChildren.empty());
+  EXPECT_TRUE(instance->children().empty());
+  for (auto& child : oldChildren)
+  {
+    EXPECT_FALSE(child->parent());
+  }
+  EXPECT_FALSE(document->getElementByKey(descendantId));
+  EXPECT_FALSE(document->getElementByIdNumber(descendant->idNumber()));
+
+  // the old subtree no longer reaches the document, editing it does not touch the index
+  auto descendantParent = descendant->parent();
+  ASSERT_TRUE(descendantParent);
+  descendantParent->removeChild(descendant);
+  descendantParent->addChild(descendant);
+  EXPECT_FALSE(document->getElementByKey(descendantId));
+}
+
 } // namespace VGG::Layout
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "Domain/Layout/FrameSubset.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace VGG;
+using namespace nlohmann;
+
+namespace
+{
+std::vector<std::string> ids(const json& items)
+{
+  std::vector<std::string> result;
+  for (auto& item : items)
+  {
+    result.push_back(item["id"]);
+  }
+  return result;
+}
+
+json makeDocument()
+{
+  return json::parse(R"({
+    "version": "1",
+    "frames": [
+      { "id": "a", "childObjects": [
+        { "id": "a1", "class": "symbolInstance", "masterId": "m1" } ] },
+      { "id": "b", "childObjects": [ { "id": "b1", "class": "path" } ] },
+      { "id": "masters", "childObjects": [
+        { "id": "m1", "class": "symbolMaster", "childObjects": [
+          { "id": "m1i", "class": "symbolInstance", "masterId": "r1", "overrideValues": [
+            { "objectId": [ "x" ], "overrideName": "masterId", "overrideValue": "m2" } ] } ] } ] },
+      { "id": "more", "childObjects": [ { "id": "m2", "class": "symbolMaster" } ] },
+      { "id": "unused", "childObjects": [ { "id": "m3", "class": "symbolMaster" } ] }
+    ],
+    "references": [
+      { "id": "r1", "class": "symbolMaster" },
+      { "id": "r2", "class": "symbolMaster" }
+    ]
+  })");
+}
+} // namespace
+
+TEST(FrameSubsetTests, KeepsRequestedFramesAndTheirMasters)
+{
+  auto doc = Layout::selectFrames(makeDocument(), { "a" });
+
+  EXPECT_EQ(doc["version"], "1");
+  EXPECT_EQ(ids(doc["frames"]), (std::vector<std::string>{ "a", "masters", "more" }));
+  EXPECT_EQ(ids(doc["references"]), (std::vector<std::string>{ "r1" }));
+}
+
+TEST(FrameSubsetTests, FrameWithoutInstances)
+{
+  auto doc = Layout::selectFrames(makeDocument(), { "b" });
+
+  EXPECT_EQ(ids(doc["frames"]), (std::vector<std::string>{ "b" }));
+  EXPECT_FALSE(doc.contains("references"));
+}
+
+TEST(FrameSubsetTests, KeepsDocumentOrder)
+{
+  auto doc = Layout::selectFrames(makeDocument(), { "unused", "b" });
+
+  EXPECT_EQ(ids(doc["frames"]), (std::vector<std::string>{ "b", "unused" }));
+}
@@ -272,4 +272,122 @@ TEST_F(VggLayoutTestSuite, Fill_width_item_in_fixed_width_container)
   std::vector<Layout::Rect> expectedFrames{ { { 260, 0 }, { 1400, 101 } } };
 
   EXPECT_TRUE(descendantFrame({ 0 }, 0) == expectedFrames[0]);
-}
\ No newline at end of file
+}
+
+TEST_F(VggLayoutTestSuite, FrameChangeReport)
+{
+  setupWithExpanding("testDataDir/layout/0_space_between/");
+  m_sut->setFrameChangeReportEnabled(true);
+
+  // When
+  layout(Layout::Size{ 1400, 900 });
+
+  // Then
+  auto changedNodes = m_sut->takeChangedNodes();
+  auto isChanged = [&changedNodes](const LayoutNode* node)
+  {
+    return std::any_of(
+      changedNodes.begin(),
+      changedNodes.end(),
+      [node](const auto& weakNode) { return weakNode.lock().get() == node; });
+  };
+  EXPECT_TRUE(isChanged(firstPage().get()));
+  EXPECT_TRUE(isChanged(firstPage()->children()[1].get()));
+  EXPECT_FALSE(firstPage()->hasNeedsLayoutDescendant());
+
+  // When: same size again
+  layout(Layout::Size{ 1400, 900 });
+
+  // Then
+  EXPECT_TRUE(m_sut->takeChangedNodes().empty());
+}
+
+TEST_F(VggLayoutTestSuite, ChildChangeStopsAtFixedSizeContainer)
+{
+  // Given: a fixed size container laid out alone, and one nested in the flex tree of the page
+  setupWithExpanding("testDataDir/layout/208_fixed_size_container/");
+  layout(Layout::Size{ 1000, 200 });
+  auto page = firstPage();
+  auto absoluteContainer = page->children()[0];
+  auto relativeContainer = page->children()[1];
+  ASSERT_FALSE(page->hasNeedsLayoutDescendant());
+
+  // When
+  absoluteContainer->children()[0]->setContainerNeedsLayout();
+
+  // Then
+  EXPECT_TRUE(absoluteContainer->needsLayout());
+  EXPECT_FALSE(page->needsLayout());
+  EXPECT_TRUE(page->hasNeedsLayoutDescendant());
+  EXPECT_FALSE(relativeContainer->hasNeedsLayoutDescendant());
+
+  // When: the flex engine lays out a nested flex container with its outer tree
+  relativeContainer->children()[0]->setContainerNeedsLayout();
+
+  // Then
+  EXPECT_TRUE(page->needsLayout());
+}
+
+TEST_F(VggLayoutTestSuite, CleanSubtreeIsNotLaidOut)
+{
+  // Given
+  setupWithExpanding("testDataDir/layout/208_fixed_size_container/");
+  layout(Layout::Size{ 1000, 200 });
+  auto page = firstPage();
+  auto dirtyItem = page->children()[0]->children()[0];
+  auto cleanItem = page->children()[1]->children()[0];
+  const auto dirtyItemFrame = dirtyItem->frame();
+  const auto cleanItemFrame = cleanItem->frame();
+
+  // moving a leaf item does not mark anything, a layout of its container would move it back
+  auto moved = [](Layout::Rect frame)
+  {
+    frame.origin.x += 50;
+    return frame;
+  };
+  cleanItem->setFrame(moved(cleanItemFrame));
+  dirtyItem->setFrame(moved(dirtyItemFrame));
+  ASSERT_FALSE(page->hasNeedsLayoutDescendant());
+
+  // When
+  dirtyItem->setContainerNeedsLayout();
+  m_sut->layoutTree()->layoutIfNeeded();
+
+  // Then
+  EXPECT_TRUE(dirtyItem->frame() == dirtyItemFrame);
+  EXPECT_TRUE(cleanItem->frame() == moved(cleanItemFrame));
+  EXPECT_FALSE(page->hasNeedsLayoutDescendant());
+}
+
+TEST_F(VggLayoutTestSuite, HitTestPath)
+{
+  // Given
+  setupWithExpanding("testDataDir/layout/1_wrap/");
+  auto page = m_sut->layoutTree()->children()[0];
+  auto listenerId = page->children()[0]->id();
+
+  LayoutNode::HitTestHook hooks[] = { nullptr,
+                                      [&listenerId](const std::string& key)
+                                      { return key == listenerId; } };
+
+  for (int x = 0; x < 800; x += 50)
+  {
+    for (int y = 0; y < 600; y += 50)
+    {
+      Layout::Point p{ page->frame().origin.x + x, page->frame().origin.y + y };
+
+      // When
+      LayoutNode::HitPath path;
+      page->hitTestPath(p, path);
+
+      // Then
+      for (const auto& hook : hooks)
+      {
+        auto expected = page->hitTest(p, hook);
+        auto target = LayoutNode::hitTest(path, hook);
+        EXPECT_EQ(target.first, expected.first);
+        EXPECT_EQ(target.second, expected.second);
+      }
+    }
+  }
+}
@@ -2,9 +2,14 @@
 #include "test_config.hpp"
 
 #include "Domain/Model/DesignModel.hpp"
+#include "Domain/Model/DesignModelParser.hpp"
+#include "Domain/Model/SnapshotCache.hpp"
 
 #include <gtest/gtest.h>
 
+#include <filesystem>
+#include <fstream>
+
 using namespace VGG::Model;
 
 class DesignModelTestSuite : public ::testing::Test
@@ -35,4 +40,50 @@ TEST_F(DesignModelTestSuite, SymbolInstance)
 
   nlohmann::json json = data;
   EXPECT_EQ(json["frames"].size(), 2);
-}
\ No newline at end of file
+}
+
+TEST_F(DesignModelTestSuite, StreamingParse)
+{
+  std::string filePath = "testDataDir/symbol/symbol_instance/design.json";
+  auto        designJson = Helper::load_json(filePath);
+
+  auto data = parseDesignModel(designJson.dump());
+  ASSERT_TRUE(data);
+  EXPECT_EQ(data->frames.size(), 2);
+
+  nlohmann::json expected = DesignModel(designJson);
+  nlohmann::json json = *data;
+  EXPECT_EQ(json, expected);
+}
+
+TEST_F(DesignModelTestSuite, SnapshotCache)
+{
+  std::string filePath = "testDataDir/symbol/symbol_instance/design.json";
+  auto        designJson = Helper::load_json(filePath);
+
+  const auto dir = std::filesystem::temp_directory_path() / "vgg_snapshot_test";
+  std::filesystem::remove_all(dir);
+  SnapshotCache cache{ dir };
+
+  const auto key = SnapshotCache::keyFor(designJson.dump());
+  EXPECT_FALSE(cache.load(key));
+
+  DesignModel model = designJson;
+  EXPECT_TRUE(cache.save(key, model));
+
+  auto loaded = cache.load(key);
+  ASSERT_TRUE(loaded);
+  nlohmann::json expected = model;
+  nlohmann::json json = *loaded;
+  EXPECT_EQ(json, expected);
+
+  EXPECT_NE(SnapshotCache::keyFor(designJson.dump(2)), key);
+
+  // a snapshot of another version is removed instead of being read
+  const auto path = dir / (key + ".vggsnap");
+  std::ofstream(path, std::ios::binary) << "vggsnap 0 0.0.1\n";
+  EXPECT_FALSE(cache.load(key));
+  EXPECT_FALSE(std::filesystem::exists(path));
+
+  std::filesystem::remove_all(dir);
+}
@@ -49,4 +49,43 @@ TEST_F(VggExecTestSuite, Smoke)
   result = sut.evalScript("1");
   // Then
   EXPECT_EQ(result, false);
-}
\ No newline at end of file
+}
+TEST_F(VggExecTestSuite, ClearModuleCache)
+{
+  // Given
+  auto mock_js_engine = new VggJSEngineMock();
+
+  std::shared_ptr<IVggEnv>     env_ptr{ new VggEnv() };
+  std::shared_ptr<VggJSEngine> js_ptr{ mock_js_engine };
+
+  VggExec sut(js_ptr, env_ptr);
+
+  // Then
+  EXPECT_CALL(*mock_js_engine, evalScript(_)).Times(0);
+  EXPECT_CALL(*mock_js_engine, clearModuleCache()).Times(1);
+
+  // When
+  sut.clearModuleCache();
+}
+TEST_F(VggExecTestSuite, PostEvent)
+{
+  // Given
+  auto mock_js_engine = new VggJSEngineMock();
+
+  std::shared_ptr<IVggEnv>     env_ptr{ new VggEnv() };
+  std::shared_ptr<VggJSEngine> js_ptr{ mock_js_engine };
+
+  VggExec sut(js_ptr, env_ptr);
+
+  // Then
+  EXPECT_CALL(*mock_js_engine, evalScript(_)).Times(0);
+  EXPECT_CALL(*mock_js_engine, evalModule(_)).Times(0);
+  EXPECT_CALL(*mock_js_engine, postEvent(R"({"type":"select"})", "select", env_ptr))
+    .WillOnce(Return(true));
+
+  // When
+  auto result = sut.postEvent(R"({"type":"select"})", "select");
+
+  // Then
+  EXPECT_TRUE(result);
+}
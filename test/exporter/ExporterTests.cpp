@@ -0,0 +1,48 @@
+#include "VGG/Exporter/ImageExporter.hpp"
+#include "domain/model/daruma_helper.hpp"
+
+#include <gtest/gtest.h>
+
+#include <VGGVersion_generated.h>
+
+using namespace VGG;
+using namespace VGG::exporter;
+
+namespace
+{
+constexpr auto DESIGN_FILE = "testDataDir/layout/208_fixed_size_container/design.json";
+constexpr auto LAYOUT_FILE = "testDataDir/layout/208_fixed_size_container/layout.json";
+} // namespace
+
+class ExporterTestSuite : public ::testing::Test
+{
+protected:
+  Exporter m_exporter{ EBackend::CPU };
+};
+
+TEST_F(ExporterTestSuite, VersionMismatchBeforeFirstFrame)
+{
+  auto design = Helper::load_json(DESIGN_FILE);
+  design["version"] = "0.0.1";
+
+  BuilderResult result;
+  auto iter = m_exporter.render(design, Helper::load_json(LAYOUT_FILE), {}, {}, result);
+  ASSERT_TRUE(result.type);
+  EXPECT_EQ(*result.type, BuilderResult::VERSION_MISMATCH);
+
+  // still exported
+  std::string       key;
+  std::vector<char> image;
+  EXPECT_TRUE(iter.next(key, image));
+}
+
+TEST_F(ExporterTestSuite, RequiredVersion)
+{
+  auto design = Helper::load_json(DESIGN_FILE);
+  design["version"] = VGG_PARSE_FORMAT_VER_STR;
+
+  BuilderResult result;
+  auto iter = m_exporter.render(design, Helper::load_json(LAYOUT_FILE), {}, {}, result);
+  EXPECT_FALSE(result.type);
+  EXPECT_TRUE(result.timeCost);
+}
@@ -0,0 +1,170 @@
+#include "Layer/Exporter/ImageExporter.hpp"
+#include "VGG/Exporter/ImageExporter.hpp"
+#include "domain/model/daruma_helper.hpp"
+
+#include <gtest/gtest.h>
+
+#include <core/SkPaint.h>
+#include <core/SkSurface.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+using namespace VGG;
+using namespace VGG::exporter;
+
+namespace
+{
+constexpr auto DESIGN_FILE = "testDataDir/layout/208_fixed_size_container/design.json";
+constexpr auto LAYOUT_FILE = "testDataDir/layout/208_fixed_size_container/layout.json";
+
+struct Pixels
+{
+  std::string          key;
+  int                  width{ 0 };
+  int                  height{ 0 };
+  std::size_t          rowBytes{ 0 };
+  std::vector<uint8_t> data;
+  bool                 ok{ false };
+
+  const uint8_t* at(int x, int y) const
+  {
+    return data.data() + y * rowBytes + x * 4;
+  }
+};
+} // namespace
+
+class PixelExportTestSuite : public ::testing::Test
+{
+protected:
+  Exporter m_exporter{ EBackend::CPU };
+
+  ImageIterator render(const ImageOption& option)
+  {
+    BuilderResult result;
+    return m_exporter.render(
+      Helper::load_json(DESIGN_FILE),
+      Helper::load_json(LAYOUT_FILE),
+      option,
+      {},
+      result);
+  }
+
+  // rows padded by padding bytes to check that the stride of the allocator is used
+  Pixels nextPixels(ImageIterator& iter, std::size_t padding = 0)
+  {
+    Pixels pixels;
+    pixels.ok = iter.nextPixels(
+      pixels.key,
+      [&](int w, int h, std::size_t& rowBytes) -> void*
+      {
+        rowBytes += padding;
+        pixels.width = w;
+        pixels.height = h;
+        pixels.rowBytes = rowBytes;
+        pixels.data.assign(rowBytes * h, 0);
+        return pixels.data.data();
+      });
+    return pixels;
+  }
+};
+
+TEST_F(PixelExportTestSuite, BgraIsSwizzledRgba)
+{
+  ImageOption option;
+  auto        rgbaIter = render(option);
+  const auto  rgba = nextPixels(rgbaIter);
+  ASSERT_TRUE(rgba.ok);
+
+  option.pixelFormat = EPixelFormat::BGRA_8888;
+  auto       bgraIter = render(option);
+  const auto bgra = nextPixels(bgraIter, 16);
+  ASSERT_TRUE(bgra.ok);
+  EXPECT_EQ(bgra.key, rgba.key);
+  ASSERT_EQ(bgra.width, rgba.width);
+  ASSERT_EQ(bgra.height, rgba.height);
+  EXPECT_EQ(bgra.rowBytes, std::size_t(bgra.width * 4 + 16));
+
+  for (int y = 0; y < rgba.height; ++y)
+  {
+    for (int x = 0; x < rgba.width; ++x)
+    {
+      const auto s = rgba.at(x, y);
+      const auto d = bgra.at(x, y);
+      ASSERT_TRUE(d[0] == s[2] && d[1] == s[1] && d[2] == s[0] && d[3] == s[3])
+        << "pixel " << x << ", " << y;
+    }
+  }
+}
+
+TEST_F(PixelExportTestSuite, FailedFrameIsSkipped)
+{
+  auto        iter = render({});
+  std::string key;
+  EXPECT_FALSE(iter.nextPixels(key, [](int, int, std::size_t&) -> void* { return nullptr; }));
+  EXPECT_EQ(key, "3:1"); // the failed frame
+
+  EXPECT_FALSE(iter.nextPixels(key, [](int, int, std::size_t&) -> void* { return nullptr; }));
+  EXPECT_TRUE(key.empty()); // the end, the failed frame is not retried
+}
+
+TEST_F(PixelExportTestSuite, PixelCallback)
+{
+  auto        iter = render({});
+  std::string key;
+  PixelView   view;
+  EXPECT_TRUE(iter.nextPixels(
+    [&](const std::string& k, const PixelView& pixels)
+    {
+      key = k;
+      view = pixels;
+      return true;
+    }));
+  EXPECT_EQ(key, "3:1");
+  EXPECT_EQ(view.width, 1000);
+  EXPECT_EQ(view.height, 200);
+  ASSERT_NE(view.data, nullptr);
+  EXPECT_EQ(uint8_t(view.data[3]), 0xff); // on a white background
+  EXPECT_FALSE(iter.nextPixels([](const std::string&, const PixelView&) { return true; }));
+}
+
+TEST(RawPixelsTest, PremultipliedAndUnpremultiplied)
+{
+  auto surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(4, 2));
+  ASSERT_TRUE(surface);
+  SkPaint paint;
+  paint.setBlendMode(SkBlendMode::kSrc);
+  paint.setColor(SkColorSetARGB(128, 200, 100, 50));
+  surface->getCanvas()->drawPaint(paint);
+
+  layer::ImageOptions opts;
+  opts.encode = layer::EImageEncode::IE_RAW;
+  opts.extend[0] = 4;
+  opts.extend[1] = 2;
+  const auto near = [](uint8_t a, int b) { return std::abs(a - b) <= 1; };
+
+  for (auto format : { layer::EPixelFormat::RGBA_8888, layer::EPixelFormat::BGRA_8888 })
+  {
+    const bool bgra = format == layer::EPixelFormat::BGRA_8888;
+    opts.pixelFormat = format;
+    for (bool premultiplied : { false, true })
+    {
+      opts.premultiplied = premultiplied;
+      const auto           rowBytes = layer::exporter::rawImageInfo(opts).minRowBytes();
+      std::vector<uint8_t> pixels(rowBytes * 2);
+      ASSERT_TRUE(layer::exporter::readPixels(opts, surface.get(), pixels.data(), rowBytes));
+
+      const int r = premultiplied ? 100 : 200;
+      const int g = premultiplied ? 50 : 100;
+      const int b = premultiplied ? 25 : 50;
+      for (std::size_t i = 0; i < pixels.size(); i += 4)
+      {
+        const auto p = pixels.data() + i;
+        EXPECT_TRUE(
+          near(p[bgra ? 2 : 0], r) && near(p[1], g) && near(p[bgra ? 0 : 2], b) && p[3] == 128)
+          << "bgra " << bgra << ", premultiplied " << premultiplied << ", byte " << i;
+      }
+    }
+  }
+}
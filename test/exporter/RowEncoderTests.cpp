@@ -0,0 +1,458 @@
+#include "Entry/Exporter/RowEncoder.hpp"
+#include "Layer/Exporter/ImageExporter.hpp"
+#include "VGG/Exporter/ImageExporter.hpp"
+#include "domain/model/daruma_helper.hpp"
+
+#include <gtest/gtest.h>
+#include <miniz.h>
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <vector>
+
+using namespace VGG;
+using namespace VGG::exporter;
+
+namespace
+{
+constexpr auto DESIGN_FILE = "testDataDir/layout/208_fixed_size_container/design.json";
+constexpr auto LAYOUT_FILE = "testDataDir/layout/208_fixed_size_container/layout.json";
+
+struct DecodedPng
+{
+  int                   width{ 0 };
+  int                   height{ 0 };
+  uint8_t               colorType{ 0 };
+  std::vector<uint32_t> palette; // 0xRRGGBB
+  std::vector<uint8_t>  rgb;     // 3 bytes per pixel
+};
+
+uint32_t readUint32(const uint8_t* p)
+{
+  return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+}
+
+uint8_t paeth(int a, int b, int c)
+{
+  const int p = a + b - c;
+  const int pa = std::abs(p - a);
+  const int pb = std::abs(p - b);
+  const int pc = std::abs(p - c);
+  return uint8_t(pa <= pb && pa <= pc ? a : (pb <= pc ? b : c));
+}
+
+// 8 bit gray, RGB, RGBA and indexed pngs without interlacing, the alpha is dropped
+std::optional<DecodedPng> decodePng(const std::vector<char>& data)
+{
+  static constexpr uint8_t SIGNATURE[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+  auto                     bytes = reinterpret_cast<const uint8_t*>(data.data());
+  if (data.size() < sizeof(SIGNATURE) || std::memcmp(bytes, SIGNATURE, sizeof(SIGNATURE)) != 0)
+  {
+    return std::nullopt;
+  }
+
+  DecodedPng           png;
+  std::vector<uint8_t> idat;
+  bool                 ended = false;
+  for (std::size_t pos = sizeof(SIGNATURE); pos + 12 <= data.size() && !ended;)
+  {
+    const auto  size = readUint32(bytes + pos);
+    const auto  type = std::string(data.data() + pos + 4, 4);
+    const auto* chunk = bytes + pos + 8;
+    if (pos + 12 + size > data.size())
+    {
+      return std::nullopt;
+    }
+    if (readUint32(chunk + size) != mz_crc32(MZ_CRC32_INIT, bytes + pos + 4, size + 4))
+    {
+      return std::nullopt;
+    }
+
+    if (type == "IHDR")
+    {
+      png.width = int(readUint32(chunk));
+      png.height = int(readUint32(chunk + 4));
+      png.colorType = chunk[9];
+      if (chunk[8] != 8 || chunk[12] != 0)
+      {
+        return std::nullopt;
+      }
+    }
+    else if (type == "PLTE")
+    {
+      for (uint32_t i = 0; i + 3 <= size; i += 3)
+      {
+        png.palette.push_back((chunk[i] << 16) | (chunk[i + 1] << 8) | chunk[i + 2]);
+      }
+    }
+    else if (type == "IDAT")
+    {
+      idat.insert(idat.end(), chunk, chunk + size);
+    }
+    else if (type == "IEND")
+    {
+      ended = true;
+    }
+    pos += 12 + size;
+  }
+  if (!ended)
+  {
+    return std::nullopt;
+  }
+
+  int channels = 0;
+  switch (png.colorType)
+  {
+    case 0:
+    case 3:
+      channels = 1;
+      break;
+    case 2:
+      channels = 3;
+      break;
+    case 6:
+      channels = 4;
+      break;
+    default:
+      return std::nullopt;
+  }
+
+  std::size_t inflatedSize = 0;
+  auto        inflated = static_cast<uint8_t*>(
+    tinfl_decompress_mem_to_heap(idat.data(), idat.size(), &inflatedSize, TINFL_FLAG_PARSE_ZLIB_HEADER));
+  const std::size_t stride = std::size_t(png.width) * channels;
+  if (!inflated || inflatedSize != (stride + 1) * png.height)
+  {
+    mz_free(inflated);
+    return std::nullopt;
+  }
+
+  std::vector<uint8_t> previous(stride, 0);
+  std::vector<uint8_t> row(stride);
+  for (int y = 0; y < png.height; ++y)
+  {
+    const uint8_t* line = inflated + y * (stride + 1);
+    for (std::size_t x = 0; x < stride; ++x)
+    {
+      const int a = x >= std::size_t(channels) ? row[x - channels] : 0;
+      const int b = previous[x];
+      const int c = x >= std::size_t(channels) ? previous[x - channels] : 0;
+      const int predictors[] = { 0, a, b, (a + b) / 2, paeth(a, b, c) };
+      if (line[0] > 4)
+      {
+        mz_free(inflated);
+        return std::nullopt;
+      }
+      row[x] = uint8_t(line[x + 1] + predictors[line[0]]);
+    }
+
+    for (int x = 0; x < png.width; ++x)
+    {
+      const uint8_t* p = row.data() + x * channels;
+      uint32_t       c = 0;
+      if (png.colorType == 3)
+      {
+        c = p[0] < png.palette.size() ? png.palette[p[0]] : 0;
+      }
+      else if (png.colorType == 0)
+      {
+        c = (p[0] << 16) | (p[0] << 8) | p[0];
+      }
+      else
+      {
+        c = (p[0] << 16) | (p[1] << 8) | p[2];
+      }
+      png.rgb.push_back(uint8_t(c >> 16));
+      png.rgb.push_back(uint8_t(c >> 8));
+      png.rgb.push_back(uint8_t(c));
+    }
+    previous = row;
+  }
+  mz_free(inflated);
+  return png;
+}
+
+// Opaque rgba rows with padding at the end of each row
+std::vector<uint8_t> makeRows(int width, int height, std::size_t rowBytes)
+{
+  std::vector<uint8_t> rows(rowBytes * height, 0xcd);
+  for (int y = 0; y < height; ++y)
+  {
+    for (int x = 0; x < width; ++x)
+    {
+      auto p = rows.data() + y * rowBytes + x * 4;
+      p[0] = uint8_t(x * 17 + y);
+      p[1] = uint8_t(y * 29);
+      p[2] = uint8_t(x * y);
+      p[3] = 0xff;
+    }
+  }
+  return rows;
+}
+
+std::vector<uint8_t> rgbOf(const uint8_t* rgba, std::size_t pixelCount)
+{
+  std::vector<uint8_t> rgb;
+  for (std::size_t i = 0; i < pixelCount; ++i, rgba += 4)
+  {
+    rgb.insert(rgb.end(), rgba, rgba + 3);
+  }
+  return rgb;
+}
+
+// Writes the rows in bands of bandHeight, the last band is shorter if height is not a multiple.
+bool encode(
+  RowEncoder&                 encoder,
+  const std::vector<uint8_t>& rows,
+  std::size_t                 rowBytes,
+  int                         height,
+  int                         bandHeight)
+{
+  for (int top = 0; top < height; top += bandHeight)
+  {
+    if (!encoder.writeRows(rows.data() + top * rowBytes, rowBytes, std::min(bandHeight, height - top)))
+    {
+      return false;
+    }
+  }
+  return encoder.finish();
+}
+
+StreamCallback appendTo(std::vector<char>& out)
+{
+  return [&out](const char* data, std::size_t size)
+  {
+    out.insert(out.end(), data, data + size);
+    return true;
+  };
+}
+} // namespace
+
+TEST(RowEncoderTest, PngIsRgbAcrossBandEdges)
+{
+  constexpr int         width = 13;
+  constexpr int         height = 7;
+  constexpr std::size_t rowBytes = width * 4 + 8;
+  const auto            rows = makeRows(width, height, rowBytes);
+
+  std::vector<char> out;
+  PngRowEncoder     sut{ width, height, 100, EEncodeProfile::DEFAULT, appendTo(out) };
+  ASSERT_TRUE(encode(sut, rows, rowBytes, height, 3));
+
+  auto png = decodePng(out);
+  ASSERT_TRUE(png);
+  EXPECT_EQ(png->width, width);
+  EXPECT_EQ(png->height, height);
+  EXPECT_EQ(png->colorType, 2);
+  for (int y = 0; y < height; ++y)
+  {
+    const auto expected = rgbOf(rows.data() + y * rowBytes, width);
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), png->rgb.begin() + y * width * 3))
+      << "row " << y;
+  }
+}
+
+TEST(RowEncoderTest, PngLevelOfEncodeProfile)
+{
+  EXPECT_EQ(PngRowEncoder::zlibLevel(100, EEncodeProfile::FAST), 1);
+  EXPECT_EQ(PngRowEncoder::zlibLevel(100, EEncodeProfile::BALANCED), 6);
+  EXPECT_EQ(PngRowEncoder::zlibLevel(100, EEncodeProfile::SMALLEST), 9);
+  EXPECT_EQ(PngRowEncoder::zlibLevel(100, EEncodeProfile::DEFAULT), 0);
+  EXPECT_EQ(PngRowEncoder::zlibLevel(35), 6);
+
+  constexpr int         width = 64;
+  constexpr int         height = 16;
+  constexpr std::size_t rowBytes = width * 4;
+  const auto            rows = makeRows(width, height, rowBytes);
+
+  std::vector<char> stored;
+  PngRowEncoder     level0{ width, height, 100, EEncodeProfile::DEFAULT, appendTo(stored) };
+  ASSERT_TRUE(encode(level0, rows, rowBytes, height, height));
+  std::vector<char> smallest;
+  PngRowEncoder     level9{ width, height, 100, EEncodeProfile::SMALLEST, appendTo(smallest) };
+  ASSERT_TRUE(encode(level9, rows, rowBytes, height, height));
+
+  EXPECT_LT(smallest.size(), stored.size()); // the profile wins over the quality
+  auto png = decodePng(smallest);
+  ASSERT_TRUE(png);
+  EXPECT_EQ(png->width, width);
+}
+
+TEST(RowEncoderTest, RawDropsRowPaddingAcrossBandEdges)
+{
+  constexpr int         width = 5;
+  constexpr int         height = 7;
+  constexpr std::size_t rowBytes = width * 4 + 12;
+  const auto            rows = makeRows(width, height, rowBytes);
+
+  std::vector<char> out;
+  RawRowEncoder     sut{ width, appendTo(out) };
+  ASSERT_TRUE(encode(sut, rows, rowBytes, height, 2));
+
+  ASSERT_EQ(out.size(), std::size_t(width * height * 4));
+  for (int y = 0; y < height; ++y)
+  {
+    EXPECT_EQ(std::memcmp(out.data() + y * width * 4, rows.data() + y * rowBytes, width * 4), 0)
+      << "row " << y;
+  }
+}
+
+TEST(RowEncoderTest, IndexedPng)
+{
+  constexpr int               width = 37;
+  constexpr int               height = 20;
+  const std::vector<uint32_t> palette = { 0x112233, 0xff0000, 0xffffff };
+
+  std::vector<char> out;
+  auto              sut = PngRowEncoder::makeIndexed(width, height, 9, palette, appendTo(out));
+  std::vector<uint8_t> indices(width * height);
+  for (int i = 0; i < width * height; ++i)
+  {
+    indices[i] = uint8_t((i / 7) % palette.size());
+  }
+  std::vector<uint8_t> rows(indices.begin(), indices.end());
+  ASSERT_TRUE(encode(*sut, rows, width, height, 6));
+
+  auto png = decodePng(out);
+  ASSERT_TRUE(png);
+  EXPECT_EQ(png->colorType, 3);
+  EXPECT_EQ(png->palette, palette);
+  for (int i = 0; i < width * height; ++i)
+  {
+    const auto c = palette[indices[i]];
+    ASSERT_EQ(png->rgb[i * 3], uint8_t(c >> 16)) << "pixel " << i;
+    ASSERT_EQ(png->rgb[i * 3 + 1], uint8_t(c >> 8)) << "pixel " << i;
+    ASSERT_EQ(png->rgb[i * 3 + 2], uint8_t(c)) << "pixel " << i;
+  }
+}
+
+TEST(RowEncoderTest, StopWhenCallbackFails)
+{
+  constexpr int width = 4;
+  const auto    rows = makeRows(width, 1, width * 4);
+
+  PngRowEncoder sut{
+    width, 1, 100, EEncodeProfile::DEFAULT, [](const char*, std::size_t) { return false; }
+  };
+  EXPECT_FALSE(sut.writeRows(rows.data(), width * 4, 1) && sut.finish());
+}
+
+TEST(RowEncoderTest, GrayPngOfSmallestProfile)
+{
+  constexpr int width = 300;
+  constexpr int height = 5;
+  auto          surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(width, height));
+  ASSERT_TRUE(surface);
+  // more gray levels than a palette holds
+  for (int x = 0; x < width; ++x)
+  {
+    const auto level = uint8_t(x * 255 / (width - 1));
+    SkPaint    paint;
+    paint.setColor(SkColorSetRGB(level, level, level));
+    surface->getCanvas()->drawRect(SkRect::MakeXYWH(x, 0, 1, height), paint);
+  }
+  auto image = surface->makeImageSnapshot();
+
+  layer::ImageOptions opts;
+  opts.encode = layer::EImageEncode::IE_PNG;
+  opts.extend[0] = width;
+  opts.extend[1] = height;
+  opts.profile = layer::EEncodeProfile::SMALLEST;
+  auto data = layer::exporter::encodeSnapshot(opts, image.get());
+  ASSERT_TRUE(data);
+
+  auto png = decodePng(*data);
+  ASSERT_TRUE(png);
+  EXPECT_EQ(png->colorType, 0);
+
+  SkPixmap pixmap;
+  ASSERT_TRUE(image->peekPixels(&pixmap));
+  for (int x = 0; x < width; ++x)
+  {
+    EXPECT_EQ(png->rgb[x * 3], SkColorGetR(pixmap.getColor(x, 0))) << "pixel " << x;
+  }
+}
+
+class StreamedExportTestSuite : public ::testing::Test
+{
+protected:
+  Exporter m_exporter{ EBackend::CPU };
+
+  ImageIterator render(const ImageOption& option)
+  {
+    BuilderResult result;
+    return m_exporter.render(
+      Helper::load_json(DESIGN_FILE),
+      Helper::load_json(LAYOUT_FILE),
+      option,
+      {},
+      result);
+  }
+
+  std::vector<char> surfaceImage(const ImageOption& option)
+  {
+    auto              iter = render(option);
+    std::string       key;
+    std::vector<char> image;
+    EXPECT_TRUE(iter.next(key, image));
+    return image;
+  }
+
+  std::vector<char> streamedImage(const ImageOption& option)
+  {
+    auto              iter = render(option);
+    std::string       key;
+    std::vector<char> image;
+    EXPECT_TRUE(iter.next(key, appendTo(image)));
+    EXPECT_FALSE(key.empty());
+    return image;
+  }
+};
+
+TEST_F(StreamedExportTestSuite, RawAndPngMatchSurface)
+{
+  ImageOption option;
+  option.type = EImageType::RAW;
+  const auto expected = surfaceImage(option);
+  ASSERT_FALSE(expected.empty());
+  EXPECT_EQ(streamedImage(option), expected);
+
+  option.type = EImageType::PNG;
+  auto png = decodePng(streamedImage(option));
+  ASSERT_TRUE(png);
+  EXPECT_EQ(png->colorType, 2);
+  ASSERT_EQ(std::size_t(png->width * png->height * 4), expected.size());
+  EXPECT_EQ(
+    png->rgb,
+    rgbOf(reinterpret_cast<const uint8_t*>(expected.data()), png->width * png->height));
+}
+
+TEST_F(StreamedExportTestSuite, JpegIsNotReplaced)
+{
+  ImageOption option;
+  option.type = EImageType::JPEG;
+  const auto image = streamedImage(option);
+  ASSERT_GE(image.size(), 2);
+  EXPECT_EQ(uint8_t(image[0]), 0xff); // SOI
+  EXPECT_EQ(uint8_t(image[1]), 0xd8);
+  EXPECT_EQ(image, surfaceImage(option));
+}
+
+TEST_F(StreamedExportTestSuite, IndexedPngOfSmallestProfile)
+{
+  ImageOption option;
+  option.type = EImageType::RAW;
+  const auto expected = surfaceImage(option);
+  ASSERT_FALSE(expected.empty());
+
+  option.type = EImageType::PNG;
+  option.encodeProfile = EEncodeProfile::SMALLEST;
+  auto png = decodePng(surfaceImage(option));
+  ASSERT_TRUE(png);
+  EXPECT_EQ(png->colorType, 3); // white and one green
+  EXPECT_EQ(
+    png->rgb,
+    rgbOf(reinterpret_cast<const uint8_t*>(expected.data()), png->width * png->height));
+}
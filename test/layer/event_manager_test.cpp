@@ -0,0 +1,165 @@
+#include "Layer/Core/EventManager.hpp"
+#include "Layer/Core/VNode.hpp"
+#include "Layer/Memory/VNew.hpp"
+#include "Utility/Trace.hpp"
+
+#include <nlohmann/json.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace VGG;
+using namespace VGG::layer;
+
+namespace
+{
+class TestEventNode : public VNode
+{
+public:
+  using VNode::isInvalid;
+
+  TestEventNode(VRefCnt* cnt, Ref<TestEventNode> observed = nullptr)
+    : VNode(cnt)
+  {
+    if (observed)
+    {
+      observe(observed);
+    }
+  }
+
+protected:
+  Bounds onRevalidate(Revalidation* inv, const glm::mat3& ctm) override
+  {
+    return {};
+  }
+};
+
+// top observes middle, which observes leaf
+std::vector<Ref<TestEventNode>> makeChain()
+{
+  auto leaf = Ref<TestEventNode>(V_NEW<TestEventNode>());
+  auto middle = Ref<TestEventNode>(V_NEW<TestEventNode>(leaf));
+  auto top = Ref<TestEventNode>(V_NEW<TestEventNode>(middle));
+  return { leaf, middle, top };
+}
+} // namespace
+
+class EventManagerTestSuite : public ::testing::Test
+{
+protected:
+  Tracer& m_tracer = Tracer::sharedInstance();
+
+  void SetUp() override
+  {
+    EventManager::pollEvents();
+    m_tracer.setEnabled(true);
+    m_tracer.clear();
+  }
+
+  void TearDown() override
+  {
+    m_tracer.setEnabled(false);
+    m_tracer.clear();
+  }
+
+  int64_t nodesInvalidated()
+  {
+    m_tracer.markFrame();
+    auto        trace = nlohmann::json::parse(m_tracer.dumpChromeTrace());
+    const auto& events = trace["traceEvents"];
+    return events.empty() ? 0 : events.back()["args"]["nodesInvalidated"].get<int64_t>();
+  }
+};
+
+TEST_F(EventManagerTestSuite, ObserversFirst)
+{
+  auto chain = makeChain();
+  for (auto& node : chain) // leaf first, the order that walks the chain the most
+  {
+    node->update();
+  }
+  EXPECT_EQ(EventManager::pendingEvents(), chain.size());
+
+  EventManager::pollEvents();
+  EXPECT_FALSE(EventManager::hasEvents());
+  // in posting order the middle and the top would be invalidated again by the leaf and middle
+  EXPECT_EQ(nodesInvalidated(), 3);
+}
+
+TEST_F(EventManagerTestSuite, ConcurrentPosts)
+{
+  constexpr int                   CHAIN_COUNT = 16;
+  constexpr int                   THREAD_COUNT = 8;
+  std::vector<Ref<TestEventNode>> nodes;
+  for (int i = 0; i < CHAIN_COUNT; ++i)
+  {
+    auto chain = makeChain();
+    nodes.insert(nodes.end(), chain.begin(), chain.end());
+  }
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < THREAD_COUNT; ++t)
+  {
+    threads.emplace_back(
+      [nodes, t]() mutable
+      {
+        std::shuffle(nodes.begin(), nodes.end(), std::mt19937(t));
+        for (int round = 0; round < 100; ++round)
+        {
+          for (auto& node : nodes)
+          {
+            EventManager::postEvent({ node.get(), ENodeEvent::UPDATE });
+          }
+        }
+      });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_TRUE(EventManager::hasEvents());
+  EXPECT_EQ(EventManager::pendingEvents(), nodes.size()); // each node once
+
+  EventManager::pollEvents();
+  EXPECT_FALSE(EventManager::hasEvents());
+  EXPECT_EQ(EventManager::pendingEvents(), 0u);
+  EXPECT_EQ(nodesInvalidated(), int64_t(nodes.size())); // each node once, observers first
+
+  // the nodes can be queued again once polled
+  nodes.front()->update();
+  EXPECT_EQ(EventManager::pendingEvents(), 1u);
+  EventManager::pollEvents();
+}
+
+TEST_F(EventManagerTestSuite, InvalidationBatch)
+{
+  auto chain = makeChain();
+  {
+    VNode::InvalidationBatch batch;
+    for (int round = 0; round < 3; ++round)
+    {
+      for (auto& node : chain)
+      {
+        node->invalidate();
+      }
+    }
+    {
+      VNode::InvalidationBatch nested;
+      chain.front()->invalidate();
+    }
+    for (auto& node : chain)
+    {
+      EXPECT_FALSE(node->isInvalid()); // deferred until the outermost batch ends
+    }
+  }
+
+  for (auto& node : chain)
+  {
+    EXPECT_TRUE(node->isInvalid());
+  }
+  EXPECT_EQ(nodesInvalidated(), 3);
+}
@@ -12,7 +12,18 @@ public:
   MOCK_METHOD(
     bool,
     evalModule,
-    (const std::string& code, VGG::EventPtr event, std::shared_ptr<VGG::IVggEnv> env),
+    (const std::string&            handlerKey,
+     const std::string&            code,
+     VGG::EventPtr                 event,
+     std::shared_ptr<VGG::IVggEnv> env),
+    (override));
+  MOCK_METHOD(void, clearModuleCache, (), (override));
+  MOCK_METHOD(
+    bool,
+    postEvent,
+    (const std::string& event,
+     const std::string& coalesceKey,
+     std::shared_ptr<VGG::IVggEnv> env),
     (override));
 
   MOCK_METHOD(void, openUrl, (const std::string& url, const std::string& target), (override));
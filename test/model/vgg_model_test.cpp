@@ -1,6 +1,7 @@
 #include "Domain/Daruma.hpp"
 
 #include "Application/UIEvent.hpp"
+#include "Domain/Model/EventListenerTable.hpp"
 #include "Domain/RawJsonDocument.hpp"
 
 #include "domain/model/daruma_helper.hpp"
@@ -170,3 +171,31 @@ TEST_F(VggModelTestSuite, load_layout_doc)
   // Then
   EXPECT_TRUE(layoutDoc);
 }
+
+TEST_F(VggModelTestSuite, event_listener_table)
+{
+  // Given
+  std::string filePath = "testDataDir/vgg-daruma.zip";
+  auto        ret = m_sut->load(filePath);
+  EXPECT_EQ(ret, true);
+
+  const std::string code{ "console.log('hello');" };
+  m_sut->removeEventListener("/fake", g_eventNameClick, code);
+  auto tableBefore = m_sut->eventListenerTable();
+
+  // When
+  m_sut->addEventListener("/fake", g_eventNameClick, code);
+  auto tableAfterAdd = m_sut->eventListenerTable();
+  m_sut->removeEventListener("/fake", g_eventNameClick, code);
+  auto tableAfterRemove = m_sut->eventListenerTable();
+
+  // Then
+  EXPECT_FALSE(tableBefore->has("/fake", g_eventNameClick));
+  ASSERT_TRUE(tableAfterAdd->has("/fake", g_eventNameClick));
+  auto& listener = tableAfterAdd->find("/fake", g_eventNameClick)->front();
+  EXPECT_EQ(*listener.code, code);
+  EXPECT_FALSE(listener.fileName.empty());
+  EXPECT_FALSE(tableAfterAdd->has("/fake", "mousemove"));
+  EXPECT_FALSE(tableAfterRemove->has("/fake", g_eventNameClick));
+  EXPECT_TRUE(tableAfterRemove->find("/artboard/layers/0/childObjects"));
+}
@@ -0,0 +1,105 @@
+#include "Adapter/NativeJsEventBatch.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace VGG;
+
+namespace
+{
+NativeJsEvent makeEvent(
+  const std::string& event,
+  const std::string& coalesceKey = {},
+  const std::string& listenerKey = "listener")
+{
+  NativeJsEvent result;
+  result.m_args = { "container", "env", "instance", listenerKey, "envName", "vggName", event };
+  result.m_coalesce_key = coalesceKey;
+  return result;
+}
+
+std::vector<std::string> eventsOf(const NativeJsEventBatch& batch)
+{
+  std::vector<std::string> result;
+  for (auto& e : batch.events())
+  {
+    result.push_back(e.m_args.back());
+  }
+  return result;
+}
+} // namespace
+
+TEST(NativeJsEventBatchTest, CoalesceSameKeyAndListener)
+{
+  NativeJsEventBatch sut;
+
+  EXPECT_TRUE(sut.add(makeEvent("select 1", "select")));
+  EXPECT_TRUE(sut.add(makeEvent("hover 1", "hover")));
+  EXPECT_TRUE(sut.add(makeEvent("other listener", "select", "listener2")));
+  EXPECT_TRUE(sut.add(makeEvent("select 2", "select")));
+
+  EXPECT_EQ(
+    eventsOf(sut),
+    (std::vector<std::string>{ "hover 1", "other listener", "select 2" }));
+  EXPECT_EQ(sut.droppedEvents(), 0);
+}
+
+TEST(NativeJsEventBatchTest, NotCoalesceAcrossDiscreteEvent)
+{
+  NativeJsEventBatch sut;
+
+  EXPECT_TRUE(sut.add(makeEvent("select 1", "select")));
+  EXPECT_TRUE(sut.add(makeEvent("click")));
+  EXPECT_TRUE(sut.add(makeEvent("select 2", "select")));
+  EXPECT_TRUE(sut.add(makeEvent("keydown")));
+  EXPECT_TRUE(sut.add(makeEvent("keydown")));
+
+  EXPECT_EQ(
+    eventsOf(sut),
+    (std::vector<std::string>{ "select 1", "click", "select 2", "keydown", "keydown" }));
+}
+
+TEST(NativeJsEventBatchTest, FullBatchDropsOldestCoalescableEvent)
+{
+  NativeJsEventBatch sut{ 3 };
+
+  EXPECT_TRUE(sut.add(makeEvent("click 1")));
+  EXPECT_TRUE(sut.add(makeEvent("select", "select")));
+  EXPECT_TRUE(sut.add(makeEvent("hover", "hover")));
+  EXPECT_TRUE(sut.add(makeEvent("click 2")));
+
+  EXPECT_EQ(eventsOf(sut), (std::vector<std::string>{ "click 1", "hover", "click 2" }));
+  EXPECT_EQ(sut.droppedEvents(), 1);
+
+  // "hover" can not be coalesced across "click 2", it is dropped to make room
+  EXPECT_TRUE(sut.add(makeEvent("hover 2", "hover")));
+  EXPECT_EQ(eventsOf(sut), (std::vector<std::string>{ "click 1", "click 2", "hover 2" }));
+  EXPECT_EQ(sut.droppedEvents(), 2);
+}
+
+TEST(NativeJsEventBatchTest, FullBatchCoalescesWithoutDropping)
+{
+  NativeJsEventBatch sut{ 2 };
+
+  EXPECT_TRUE(sut.add(makeEvent("click")));
+  EXPECT_TRUE(sut.add(makeEvent("hover 1", "hover")));
+  EXPECT_TRUE(sut.add(makeEvent("hover 2", "hover")));
+
+  EXPECT_EQ(eventsOf(sut), (std::vector<std::string>{ "click", "hover 2" }));
+  EXPECT_EQ(sut.droppedEvents(), 0);
+}
+
+TEST(NativeJsEventBatchTest, FullBatchKeepsDiscreteEvents)
+{
+  NativeJsEventBatch sut{ 2 };
+
+  EXPECT_TRUE(sut.add(makeEvent("click 1")));
+  EXPECT_TRUE(sut.add(makeEvent("click 2")));
+
+  auto click = makeEvent("click 3");
+  EXPECT_FALSE(sut.add(std::move(click)));
+  EXPECT_EQ(click.m_args.back(), "click 3");
+  EXPECT_FALSE(sut.add(makeEvent("select", "select")));
+
+  EXPECT_EQ(eventsOf(sut), (std::vector<std::string>{ "click 1", "click 2" }));
+  EXPECT_EQ(sut.droppedEvents(), 0);
+}
@@ -26,6 +26,7 @@ void write(InputIterator iter, F&& f, const std::string& ext = ".png")
   {
     INFO("Render Time Cost: [%f]", res.timeCost->render);
     INFO("Encode Time Cost: [%f]", res.timeCost->encode);
+    INFO("Encoded Size: [%zu]", res.timeCost->bytes);
     std::ofstream ofs(f(res.data->first) + ext, std::ios::binary);
     if (ofs.is_open())
     {
@@ -106,11 +107,25 @@ int main(int argc, char** argv)
   program.add_argument("-f", "--file-format").help("imageformat: png, jpg, webp, svg, pdf");
   program.add_argument("-t").help("postfix for output filename");
   program.add_argument("--disable-layout").help("disable layout").implicit_value(true);
+  program.add_argument("--frame").help("export the frame of the given id only").append();
+  program.add_argument("--batch").help("exports the files listed in the given file, - for stdin");
+  program.add_argument("--memory-limit")
+    .help("memory budget of the caches in MB, batch mode")
+    .scan<'i', int>()
+    .default_value(0);
   program.add_argument("--disable-expand")
     .help("disable replace for symbol instance")
     .implicit_value(true);
 
   program.add_argument("--repl").help("run as REPL mode").implicit_value(true);
+  program.add_argument("--cpu").help("render with the cpu backend").implicit_value(true);
+  program.add_argument("--pipeline")
+    .help("frames rendered ahead while encoding in the background, 0 to disable")
+    .scan<'i', int>()
+    .default_value(0);
+  program.add_argument("--encode-profile")
+    .help("encoder settings: default, fast, balanced or smallest")
+    .default_value(std::string("default"));
 
   try
   {
@@ -194,6 +209,19 @@ int main(int argc, char** argv)
   }
   int s = program.get<int>("-q");
   opts.imageQuality = s;
+  opts.maxFramesInFlight = program.get<int>("--pipeline");
+  if (auto profile = program.get<std::string>("--encode-profile"); profile == "fast")
+  {
+    opts.encodeProfile = exporter::EEncodeProfile::FAST;
+  }
+  else if (profile == "balanced")
+  {
+    opts.encodeProfile = exporter::EEncodeProfile::BALANCED;
+  }
+  else if (profile == "smallest")
+  {
+    opts.encodeProfile = exporter::EEncodeProfile::SMALLEST;
+  }
 
   if (auto cfg = program.present("-c"))
   {
@@ -207,8 +235,12 @@ int main(int argc, char** argv)
   if (auto cfg = program.present<bool>("--disable-layout"))
     exportOpt.enableLayout = false;
 
+  if (auto ids = program.present<std::vector<std::string>>("--frame"))
+    exportOpt.frameIds = *ids;
+
   exporter::ExporterInfo info;
-  exporter::Exporter     exporter;
+  exporter::Exporter     exporter(
+    program.present<bool>("--cpu") ? exporter::EBackend::CPU : exporter::EBackend::VULKAN);
   exporter.info(&info);
   INFO("%s", info.graphicsInfo.c_str());
   auto loadfile = program.get<std::string>(POS_ARG_INPUT_FILE);
@@ -250,51 +282,74 @@ int main(int argc, char** argv)
       }
     }
   }
-  else if (auto d = program.present("-L"))
+  else if (program.present("-L") || program.present("--batch"))
   {
-    const auto dir = desc.prefix.value_or(".") / d.value();
-    if (fs::exists(dir))
+    // one exporter for all the files, only the state of the previous document is dropped
+    exporter.setMemoryLimit(std::size_t(program.get<int>("--memory-limit")) << 20);
+    auto exportFile = [&](const fs::path& filepath)
     {
-      for (const auto& ent : fs::recursive_directory_iterator(dir))
+      desc.filepath = filepath;
+      auto r = load(desc.filepath.extension().string());
+      if (r)
       {
-        if (fs::is_regular_file(ent))
+        exporter.resetDocumentState();
+        auto data = r->read(desc.prefix.value_or(fs::path(".")) / desc.filepath);
+        layer::setGlobalResourceProvider(std::move(data.provider));
+        const fs::path prefix = outputDir;
+        fs::create_directory(prefix);
+        if (isBitmap)
         {
-          desc.filepath = ent;
-          auto r = load(desc.filepath.extension().string());
-          if (r)
+          exporter::BuilderResult res;
+          auto iter = exporter.render(data.format, nlohmann::json{}, opts, exportOpt, res);
+          std::cout << "Expand Time Cost: " << res.timeCost->expand << std::endl;
+          std::cout << "Layout Time Cost: " << res.timeCost->layout << std::endl;
+          write(
+            std::move(iter),
+            [&](auto guid) { return (prefix / (guid + outputFilePostfix)).string(); },
+            extension);
+        }
+        else
+        {
+          writeDoc(extension, prefix, outputFilePostfix, data.format, nlohmann::json{}, exportOpt);
+        }
+      }
+    };
+
+    if (auto d = program.present("-L"))
+    {
+      const auto dir = desc.prefix.value_or(".") / d.value();
+      if (fs::exists(dir))
+      {
+        for (const auto& ent : fs::recursive_directory_iterator(dir))
+        {
+          if (fs::is_regular_file(ent))
           {
-            auto data = r->read(desc.prefix.value_or(fs::path(".")) / desc.filepath);
-            layer::setGlobalResourceProvider(std::move(data.provider));
-            const fs::path prefix = outputDir;
-            fs::create_directory(prefix);
-            if (isBitmap)
-            {
-              exporter::BuilderResult res;
-              auto iter = exporter.render(data.format, nlohmann::json{}, opts, exportOpt, res);
-              std::cout << "Expand Time Cost: " << res.timeCost->expand << std::endl;
-              std::cout << "Layout Time Cost: " << res.timeCost->layout << std::endl;
-              write(
-                std::move(iter),
-                [&](auto guid) { return (prefix / (guid + outputFilePostfix)).string(); },
-                extension);
-            }
-            else
-            {
-              writeDoc(
-                extension,
-                prefix,
-                outputFilePostfix,
-                data.format,
-                nlohmann::json{},
-                exportOpt);
-            }
+            exportFile(ent);
           }
         }
       }
+      else
+      {
+        std::cout << "Directory " << dir << "not exists\n";
+      }
     }
     else
     {
-      std::cout << "Directory " << dir << "not exists\n";
+      const auto    list = program.get<std::string>("--batch");
+      std::ifstream ifs;
+      if (list != "-")
+      {
+        ifs.open(list);
+      }
+      std::istream& is = list == "-" ? std::cin : ifs;
+      std::string   line;
+      while (std::getline(is, line))
+      {
+        if (!line.empty())
+        {
+          exportFile(line);
+        }
+      }
     }
   }
   else if (auto repl = program.present<bool>("--repl"))
@@ -327,6 +382,7 @@ int main(int argc, char** argv)
       auto     r = load(ext);
       if (r)
       {
+        exporter.resetDocumentState();
         auto data = r->read(filename);
         layer::setGlobalResourceProvider(std::move(data.provider));
         auto rp = static_cast<layer::FileResourceProvider*>(